@@ -0,0 +1,410 @@
+/**
+ * @file dictionary_benchmark.cpp
+ * @brief Google Benchmark suite for the core Dictionary operations.
+ * @details Every benchmark runs over one of several reproducible corpora,
+ *          generated from fixed seeds so results are comparable between runs
+ *          and machines:
+ *          - 0 `words`: English-like words built from common syllables;
+ *          - 1 `urls`: URLs sharing a handful of hosts and deep path prefixes;
+ *          - 2 `uuids`: random version-4 UUIDs, i.e. almost no shared prefixes;
+ *          - 3 `zipf`: words drawn from a Zipf(1.0) distribution, so a few keys
+ *            repeat very often;
+ *          - 4 `wide`: random 6-character keys over a 14-letter alphabet, so the
+ *            upper levels are full Node16 tables (fan-out 5 to 16).
+ *          Set `DICTIONARY_BENCH_WORDS` to a word list (one word per line, e.g.
+ *          `/usr/share/dict/words`) to replace the `words` corpus with real data.
+ *
+ *          Each benchmark reports `time/op` per key, and the build benchmarks also
+ *          report `bytes/key` (from `memory_usage()`) and the process peak RSS.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -O2 -DNDEBUG -Iinclude benchmarks/dictionary_benchmark.cpp \
+ *     -lbenchmark -lpthread -o dictionary_benchmark
+ * ./dictionary_benchmark --benchmark_filter=WordExist
+ * @endcode
+ *
+ * `BM_Key16Find` compares the SIMD and scalar Node16 searches directly. To see
+ * the effect on whole lookups, build a second binary with `-DDICTIONARY_NO_SIMD`
+ * and compare `BM_WordExist<AdaptiveArena>/corpus:4`.
+ */
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "Dictionary.hpp"
+
+namespace {
+
+constexpr std::size_t corpus_size = 200000;
+constexpr int corpus_count = 5;
+constexpr std::array<const char*, corpus_count> corpus_names = {"words", "urls", "uuids", "zipf", "wide"};
+
+std::string english_word(std::mt19937_64 &rng) {
+    static constexpr std::array<const char*, 24> syllables = {
+        "th", "er", "on", "an", "re", "he", "in", "ed", "nd", "ha", "at", "en",
+        "es", "of", "or", "nt", "ea", "ti", "to", "it", "st", "io", "le", "is"};
+    std::string word;
+    std::size_t n = 1 + rng() % 4;
+    for (std::size_t i = 0; i < n; ++i) {
+        word += syllables[rng() % syllables.size()];
+    }
+    if (rng() % 3 == 0) {
+        word += "ing";
+    }
+    return word;
+}
+
+std::vector<std::string> make_words(std::mt19937_64 &rng) {
+    std::vector<std::string> keys;
+    if (const char* path = std::getenv("DICTIONARY_BENCH_WORDS")) {
+        std::ifstream in(path);
+        for (std::string line; keys.size() < corpus_size && std::getline(in, line);) {
+            keys.push_back(line);
+        }
+        if (!keys.empty()) {
+            return keys;
+        }
+    }
+    while (keys.size() < corpus_size) {
+        keys.push_back(english_word(rng));
+    }
+    return keys;
+}
+
+std::vector<std::string> make_urls(std::mt19937_64 &rng) {
+    static constexpr std::array<const char*, 6> hosts = {
+        "https://www.example.com/", "https://docs.example.org/", "https://api.service.io/v2/",
+        "http://cdn.static.net/assets/", "https://shop.example.com/products/", "https://news.site.co.uk/"};
+    std::vector<std::string> keys;
+    keys.reserve(corpus_size);
+    while (keys.size() < corpus_size) {
+        std::string url = hosts[rng() % hosts.size()];
+        std::size_t depth = 1 + rng() % 4;
+        for (std::size_t i = 0; i < depth; ++i) {
+            url += english_word(rng);
+            url += i + 1 < depth ? "/" : (rng() % 2 ? ".html" : "");
+        }
+        if (rng() % 4 == 0) {
+            url += "?id=" + std::to_string(rng() % 100000);
+        }
+        keys.push_back(std::move(url));
+    }
+    return keys;
+}
+
+std::vector<std::string> make_uuids(std::mt19937_64 &rng) {
+    static constexpr char hex[] = "0123456789abcdef";
+    std::vector<std::string> keys;
+    keys.reserve(corpus_size);
+    while (keys.size() < corpus_size) {
+        std::string uuid(36, '-');
+        for (std::size_t i = 0; i < uuid.size(); ++i) {
+            if (i != 8 && i != 13 && i != 18 && i != 23) {
+                uuid[i] = hex[rng() % 16];
+            }
+        }
+        uuid[14] = '4';
+        uuid[19] = hex[8 + rng() % 4];
+        keys.push_back(std::move(uuid));
+    }
+    return keys;
+}
+
+std::vector<std::string> make_zipf(std::mt19937_64 &rng) {
+    std::vector<std::string> vocabulary;
+    for (std::size_t i = 0; i < corpus_size / 4; ++i) {
+        vocabulary.push_back(english_word(rng) + std::to_string(i));
+    }
+    std::vector<double> weights(vocabulary.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+    std::vector<std::string> keys;
+    keys.reserve(corpus_size);
+    while (keys.size() < corpus_size) {
+        keys.push_back(vocabulary[pick(rng)]);
+    }
+    return keys;
+}
+
+std::vector<std::string> make_wide(std::mt19937_64 &rng) {
+    static constexpr std::string_view alphabet = "0123456789abcd";
+    std::vector<std::string> keys;
+    keys.reserve(corpus_size);
+    while (keys.size() < corpus_size) {
+        std::string key(6, '0');
+        for (char &c : key) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+/**
+ * @brief Returns corpus `id`, generating it on first use.
+ */
+const std::vector<std::string> &corpus(std::int64_t id) {
+    static std::array<std::vector<std::string>, corpus_count> cache;
+    auto &keys = cache[static_cast<std::size_t>(id)];
+    if (keys.empty()) {
+        std::mt19937_64 rng(0x5eed + static_cast<std::uint64_t>(id));
+        switch (id) {
+        case 0: keys = make_words(rng); break;
+        case 1: keys = make_urls(rng); break;
+        case 2: keys = make_uuids(rng); break;
+        case 3: keys = make_zipf(rng); break;
+        default: keys = make_wide(rng); break;
+        }
+    }
+    return keys;
+}
+
+/**
+ * @brief Keys from the same distribution that the stored corpus mostly does not contain.
+ */
+const std::vector<std::string> &misses(std::int64_t id) {
+    static std::array<std::vector<std::string>, corpus_count> cache;
+    auto &keys = cache[static_cast<std::size_t>(id)];
+    if (keys.empty()) {
+        keys = corpus(id);
+        for (std::string &key : keys) {
+            if (!key.empty()) {
+                key.back() ^= 0x20;
+            }
+        }
+    }
+    return keys;
+}
+
+int payload = 0;
+
+template<class Dict>
+void fill(Dict &dict, const std::vector<std::string> &keys) {
+    for (const std::string &key : keys) {
+        dict.insert(&payload, key);
+    }
+}
+
+double peak_rss_bytes() {
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) * 1024.0; // ru_maxrss is in KiB on Linux.
+}
+
+void set_labels(benchmark::State &state, std::size_t ops) {
+    state.SetLabel(corpus_names[static_cast<std::size_t>(state.range(0))]);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ops));
+    state.counters["time/op"] = benchmark::Counter(static_cast<double>(ops),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+void set_memory_counters(benchmark::State &state, std::size_t bytes, std::size_t keys) {
+    state.counters["bytes/key"] = static_cast<double>(bytes) / static_cast<double>(keys ? keys : 1);
+    state.counters["peak_rss"] = benchmark::Counter(peak_rss_bytes(), benchmark::Counter::kDefaults,
+                                                    benchmark::Counter::OneK::kIs1024);
+}
+
+template<class Dict>
+void BM_Insert(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    std::size_t bytes = 0, size = 0;
+    for (auto _ : state) {
+        Dict dict;
+        fill(dict, keys);
+        state.PauseTiming();
+        bytes = dict.memory_usage();
+        size = dict.size();
+        state.ResumeTiming();
+    }
+    set_labels(state, keys.size());
+    set_memory_counters(state, bytes, size);
+}
+
+template<class Dict>
+void BM_LoadSorted(benchmark::State &state) {
+    std::vector<std::string> keys = corpus(state.range(0));
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::pair<std::string_view, int*>> entries;
+    for (const std::string &key : keys) {
+        entries.emplace_back(key, &payload);
+    }
+    for (auto _ : state) {
+        Dict dict;
+        dict.load_sorted(entries);
+        benchmark::DoNotOptimize(dict.size());
+    }
+    set_labels(state, entries.size());
+}
+
+template<class Dict>
+void BM_WordExist(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    const auto &queries = state.range(1) ? misses(state.range(0)) : keys;
+    Dict dict;
+    fill(dict, keys);
+    for (auto _ : state) {
+        for (const std::string &key : queries) {
+            benchmark::DoNotOptimize(dict.word_exist(key));
+        }
+    }
+    set_labels(state, queries.size());
+}
+
+template<class Dict>
+void BM_PrefixExist(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    std::size_t length = static_cast<std::size_t>(state.range(1));
+    Dict dict;
+    fill(dict, keys);
+    for (auto _ : state) {
+        for (const std::string &key : keys) {
+            benchmark::DoNotOptimize(dict.prefix_exist(std::string_view(key).substr(0, length)));
+        }
+    }
+    set_labels(state, keys.size());
+}
+
+template<class Dict>
+void BM_AutoComplete(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    std::size_t length = static_cast<std::size_t>(state.range(1));
+    constexpr std::size_t queries = 1000;
+    Dict dict;
+    fill(dict, keys);
+    std::vector<int*> res;
+    std::size_t results = 0;
+    for (auto _ : state) {
+        results = 0;
+        for (std::size_t i = 0; i < queries; ++i) {
+            res.clear();
+            dict.auto_complete(std::string_view(keys[i * 97 % keys.size()]).substr(0, length), res);
+            results += res.size();
+        }
+        benchmark::DoNotOptimize(res.data());
+    }
+    set_labels(state, queries);
+    state.counters["results/op"] = static_cast<double>(results) / queries;
+}
+
+template<class Dict>
+void BM_Traverse(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    Dict dict;
+    fill(dict, keys);
+    for (auto _ : state) {
+        std::size_t n = 0;
+        dict.traverse([&n](int*) { ++n; });
+        benchmark::DoNotOptimize(n);
+    }
+    set_labels(state, dict.size());
+}
+
+template<class Dict>
+void BM_Clear(benchmark::State &state) {
+    const auto &keys = corpus(state.range(0));
+    std::size_t size = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Dict dict;
+        fill(dict, keys);
+        size = dict.size();
+        state.ResumeTiming();
+        dict.clear();
+    }
+    set_labels(state, size);
+}
+
+/**
+ * @brief One Node16 search per query over random sorted key blocks of 5 to 16 keys.
+ * @tparam Simd Whether to use `key16_find` or `key16_find_scalar`.
+ */
+template<bool Simd>
+void BM_Key16Find(benchmark::State &state) {
+    constexpr std::size_t blocks = 4096;
+    std::mt19937_64 rng(0x5eed);
+    std::vector<std::array<char, 16>> keys(blocks);
+    std::vector<std::size_t> sizes(blocks);
+    std::vector<char> queries(blocks);
+    for (std::size_t i = 0; i < blocks; ++i) {
+        std::array<char, 64> pool;
+        for (std::size_t j = 0; j < pool.size(); ++j) {
+            pool[j] = static_cast<char>('!' + j);
+        }
+        std::shuffle(pool.begin(), pool.end(), rng);
+        sizes[i] = 5 + rng() % 12;
+        std::sort(pool.begin(), pool.begin() + static_cast<std::ptrdiff_t>(sizes[i]));
+        std::copy_n(pool.begin(), 16, keys[i].begin());
+        // Three in four queries hit, at a random position.
+        queries[i] = rng() % 4 ? keys[i][rng() % sizes[i]] : '~';
+    }
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < blocks; ++i) {
+            found += Simd ? key16_find(keys[i].data(), sizes[i], queries[i])
+                          : key16_find_scalar(keys[i].data(), sizes[i], queries[i]);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetLabel(Simd ? "simd" : "scalar");
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * blocks));
+    state.counters["time/op"] = benchmark::Counter(static_cast<double>(blocks),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+void corpora(benchmark::internal::Benchmark* b) {
+    for (int id = 0; id < corpus_count; ++id) {
+        b->Arg(id);
+    }
+}
+
+void corpora_with_hits_and_misses(benchmark::internal::Benchmark* b) {
+    for (int id = 0; id < corpus_count; ++id) {
+        b->Args({id, 0})->Args({id, 1});
+    }
+    b->ArgNames({"corpus", "miss"});
+}
+
+void corpora_with_prefix_lengths(benchmark::internal::Benchmark* b) {
+    for (int id = 0; id < corpus_count; ++id) {
+        for (int length : {1, 2, 4, 8}) {
+            b->Args({id, length});
+        }
+    }
+    b->ArgNames({"corpus", "prefix"});
+}
+
+using MapHeap = Dictionary<int>;
+using AdaptiveArena = Dictionary<int, ArenaNodeAllocator, AdaptiveChildren>;
+
+} // namespace
+
+#define DICTIONARY_BENCHMARKS(Dict)                                                              \
+    BENCHMARK_TEMPLATE(BM_Insert, Dict)->Apply(corpora)->Unit(benchmark::kMillisecond);          \
+    BENCHMARK_TEMPLATE(BM_LoadSorted, Dict)->Apply(corpora)->Unit(benchmark::kMillisecond);      \
+    BENCHMARK_TEMPLATE(BM_WordExist, Dict)->Apply(corpora_with_hits_and_misses)                  \
+        ->Unit(benchmark::kMillisecond);                                                         \
+    BENCHMARK_TEMPLATE(BM_PrefixExist, Dict)->Apply(corpora_with_prefix_lengths)                 \
+        ->Unit(benchmark::kMillisecond);                                                         \
+    BENCHMARK_TEMPLATE(BM_AutoComplete, Dict)->Apply(corpora_with_prefix_lengths)               \
+        ->Unit(benchmark::kMillisecond);                                                         \
+    BENCHMARK_TEMPLATE(BM_Traverse, Dict)->Apply(corpora)->Unit(benchmark::kMillisecond);        \
+    BENCHMARK_TEMPLATE(BM_Clear, Dict)->Apply(corpora)->Unit(benchmark::kMillisecond)
+
+DICTIONARY_BENCHMARKS(MapHeap);
+DICTIONARY_BENCHMARKS(AdaptiveArena);
+
+BENCHMARK_TEMPLATE(BM_Key16Find, true);
+BENCHMARK_TEMPLATE(BM_Key16Find, false);
+
+BENCHMARK_MAIN();
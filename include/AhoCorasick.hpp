@@ -0,0 +1,215 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * @file AhoCorasick.hpp
+ * @brief A multi-pattern streaming matcher compiled from a populated Dictionary.
+ * @details Every word of the dictionary becomes a pattern. Scanning a text
+ *          follows one transition per character, falling back along failure
+ *          links on mismatch, so all occurrences of all patterns are found in
+ *          a single pass regardless of how many patterns there are.
+ */
+
+/**
+ * @tparam T The type of the objects associated with the patterns.
+ */
+template<class T>
+class AhoCorasick {
+private:
+    using State = std::uint32_t;
+
+    static constexpr State root = 0;
+    static constexpr State none = 0xFFFFFFFFu;
+
+    /**
+     * @brief Goto function in breadth-first order: the transitions out of state
+     *        `s` are `[first_child[s], first_child[s] + child_count[s])`, and
+     *        `labels[t]` is the character leading into state `t`.
+     */
+    std::vector<State> first_child;
+    std::vector<State> child_count;
+    std::vector<char> labels;
+
+    /**
+     * @brief The state for the longest proper suffix of this state's string that is also in the trie.
+     */
+    std::vector<State> fail;
+
+    /**
+     * @brief The nearest state along the failure chain that ends a pattern, or `none`.
+     */
+    std::vector<State> output_link;
+
+    /**
+     * @brief The object of the pattern ending exactly at each state, or nullptr.
+     */
+    std::vector<T*> outputs;
+
+    /**
+     * @brief The length of each state's string, used to turn match ends into offsets.
+     */
+    std::vector<std::uint32_t> depth;
+
+    State child(State s, char c) const {
+        const char* first = labels.data() + first_child[s];
+        const char* last = first + child_count[s];
+        const char* it = std::lower_bound(first, last, c);
+        return it != last && *it == c ? static_cast<State>(it - labels.data()) : none;
+    }
+
+    State next(State s, char c) const {
+        while (true) {
+            State t = child(s, c);
+            if (t != none) {
+                return t;
+            }
+            if (s == root) {
+                return root;
+            }
+            s = fail[s];
+        }
+    }
+
+    /**
+     * @brief Builds the goto function by walking the dictionary's own trie breadth-first.
+     * @details Each node's edges come out sorted, so they become one contiguous,
+     *          sorted run of states without copying any key.
+     * @throws std::length_error if the trie has more nodes than `State` can number.
+     */
+    template<class Dict>
+    void build(const Dict &dict) {
+        using Cursor = decltype(dict.cursor());
+        std::vector<Cursor> order{dict.cursor()};
+        labels.assign(1, '\0');
+        outputs.assign(1, nullptr);
+        depth.assign(1, 0);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            Cursor node = order[i];
+            std::uint32_t child_depth = depth[i] + 1;
+            first_child.push_back(static_cast<State>(order.size()));
+            node.for_each_child([&](char c, Cursor child) {
+                if (order.size() >= none) {
+                    throw std::length_error("AhoCorasick: too many states");
+                }
+                labels.push_back(c);
+                outputs.push_back(child.value());
+                depth.push_back(child_depth);
+                order.push_back(child);
+            });
+            child_count.push_back(static_cast<State>(order.size() - first_child[i]));
+        }
+        State n = static_cast<State>(order.size());
+
+        // Breadth-first order also guarantees every shorter state is linked first.
+        fail.assign(n, root);
+        output_link.assign(n, none);
+        for (State s = 0; s < n; ++s) {
+            for (State t = first_child[s]; t < first_child[s] + child_count[s]; ++t) {
+                if (s != root) {
+                    fail[t] = next(fail[s], labels[t]);
+                }
+                State f = fail[t];
+                output_link[t] = outputs[f] && f != root ? f : output_link[f];
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief The scanning position within one stream of text.
+     * @details Carries the automaton state and the number of characters
+     *          consumed, so a text may be fed in arbitrary chunks and matches
+     *          that straddle chunk boundaries are still reported. Several
+     *          streams can share one automaton.
+     */
+    class Stream {
+    private:
+        friend class AhoCorasick;
+        const AhoCorasick* automaton;
+        State state = root;
+        std::size_t consumed = 0;
+
+        explicit Stream(const AhoCorasick* automaton) : automaton(automaton) {}
+
+    public:
+        /**
+         * @brief Scans the next chunk of the stream.
+         * @tparam Func The type of the callable function.
+         * @param chunk The characters following those already scanned.
+         * @param func Called as `func(offset, object)` for every pattern occurrence,
+         *             where `offset` is the position of its first character counted
+         *             from the start of the stream. Occurrences are reported in
+         *             order of their last character, longest first.
+         */
+        template<typename Func>
+        void scan(std::string_view chunk, Func func) {
+            for (char c : chunk) {
+                state = automaton->next(state, c);
+                ++consumed;
+                for (State s = automaton->outputs[state] ? state : automaton->output_link[state];
+                     s != none; s = automaton->output_link[s]) {
+                    func(consumed - automaton->depth[s], automaton->outputs[s]);
+                }
+            }
+        }
+
+        /**
+         * @brief Starts a new stream: forgets partial matches and restarts offsets at 0.
+         */
+        void reset() {
+            state = root;
+            consumed = 0;
+        }
+    };
+
+    /**
+     * @brief Compiles the automaton from every word of a dictionary.
+     * @tparam Dict A dictionary whose `cursor()` provides `for_each_child` and
+     *         `value`, e.g. `Dictionary<T>` with any allocator or child layout.
+     * @param dict The patterns and their objects. The empty word, if present, is ignored.
+     * @note The automaton is a compiled copy; later changes to `dict` are not reflected.
+     * @throws std::length_error if the dictionary has 2^32 - 1 nodes or more.
+     */
+    template<class Dict>
+    explicit AhoCorasick(const Dict &dict) : stream_state(this) {
+        build(dict);
+    }
+
+    AhoCorasick(const AhoCorasick &) = delete;
+    AhoCorasick &operator=(const AhoCorasick&) = delete;
+
+    /**
+     * @brief Scans the next chunk of the automaton's built-in stream.
+     * @details Equivalent to `Stream::scan` on a stream owned by the automaton;
+     *          use `stream()` to scan several texts independently or concurrently.
+     */
+    template<typename Func>
+    void scan(std::string_view chunk, Func func) {
+        stream_state.scan(chunk, func);
+    }
+
+    /**
+     * @brief Resets the built-in stream.
+     */
+    void reset() {
+        stream_state.reset();
+    }
+
+    /**
+     * @brief Returns a new, independent stream over this automaton.
+     */
+    Stream stream() const {
+        return Stream(this);
+    }
+
+private:
+    Stream stream_state;
+};
@@ -0,0 +1,481 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <new>
+#include <memory>
+
+/**
+ * @file ConcurrentDictionary.hpp
+ * @brief A read-mostly, thread-safe variant of Dictionary.
+ * @details Readers never lock: lookups, prefix checks and traversals are
+ *          wait-free. Writers are serialized by a mutex, publish new child
+ *          tables with a single atomic store, and hand unlinked memory to
+ *          epoch-based reclamation, which frees it once no reader can still
+ *          be looking at it.
+ */
+
+/**
+ * @brief Process-wide epoch-based reclamation state shared by every ConcurrentDictionary.
+ * @details Each thread that reads owns a slot in which it announces the global
+ *          epoch it observed on entering a read section. Memory retired during
+ *          epoch `e` may be freed once the epoch has moved past `e` and no slot
+ *          still announces an epoch at or before it.
+ */
+class EpochDomain {
+private:
+    /**
+     * @brief One reader thread's announcement.
+     */
+    struct Slot {
+        /**
+         * @brief The epoch observed on entering the outermost read section, or 0 when idle.
+         */
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> in_use{false};
+        Slot* next = nullptr;
+        /**
+         * @brief Read-section nesting depth. Only touched by the owning thread.
+         */
+        unsigned depth = 0;
+    };
+
+    /**
+     * @brief Claims a slot for the calling thread when it is created and frees it
+     *        when the thread exits. Slots themselves are never deallocated.
+     */
+    struct SlotOwner {
+        Slot* slot;
+        SlotOwner() : slot(instance().acquire_slot()) {}
+        ~SlotOwner() { slot->in_use.store(false, std::memory_order_release); }
+    };
+
+    std::atomic<Slot*> slots{nullptr};
+    std::atomic<std::uint64_t> global_epoch{1};
+
+    Slot* acquire_slot() {
+        for (Slot* s = slots.load(std::memory_order_acquire); s; s = s->next) {
+            bool expected = false;
+            if (!s->in_use.load(std::memory_order_relaxed) &&
+                s->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return s;
+            }
+        }
+        Slot* s = new Slot;
+        s->in_use.store(true, std::memory_order_relaxed);
+        Slot* head = slots.load(std::memory_order_relaxed);
+        do {
+            s->next = head;
+        } while (!slots.compare_exchange_weak(head, s, std::memory_order_release, std::memory_order_relaxed));
+        return s;
+    }
+
+    static Slot* local_slot() {
+        thread_local SlotOwner owner;
+        return owner.slot;
+    }
+
+    EpochDomain() = default;
+
+public:
+    /**
+     * @brief The shared domain. Intentionally never destroyed, so threads may
+     *        still release their slots during static destruction.
+     */
+    static EpochDomain &instance() {
+        static EpochDomain* domain = new EpochDomain;
+        return *domain;
+    }
+
+    /**
+     * @brief RAII read section. While alive, nothing reachable at entry is freed.
+     * @details Entering and leaving are a fixed number of atomic operations, so
+     *          readers never wait on writers. Sections may nest.
+     */
+    class Guard {
+    private:
+        Slot* slot;
+
+    public:
+        Guard() : slot(local_slot()) {
+            if (slot->depth++ == 0) {
+                slot->epoch.store(instance().global_epoch.load(std::memory_order_acquire),
+                                  std::memory_order_relaxed);
+                // The announcement must be visible before any shared pointer is read.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            if (--slot->depth == 0) {
+                slot->epoch.store(0, std::memory_order_release);
+            }
+        }
+    };
+
+    /**
+     * @brief The current global epoch; memory unlinked now is tagged with it.
+     */
+    std::uint64_t current() const {
+        return global_epoch.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Moves the global epoch forward so new readers announce a later epoch.
+     */
+    void advance() {
+        global_epoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief The oldest epoch still announced by an active reader, or the maximum if none.
+     * @details Anything retired in an epoch strictly before this is unreachable.
+     */
+    std::uint64_t oldest_active() const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (Slot* s = slots.load(std::memory_order_acquire); s; s = s->next) {
+            std::uint64_t e = s->epoch.load(std::memory_order_acquire);
+            if (e != 0) {
+                oldest = std::min(oldest, e);
+            }
+        }
+        return oldest;
+    }
+};
+
+/**
+ * @tparam T The type of the objects associated with words.
+ */
+template<class T>
+class ConcurrentDictionary {
+private:
+    struct Node;
+
+    /**
+     * @brief An immutable, sorted snapshot of a node's children.
+     * @details Laid out as the header, then `count` child pointers, then
+     *          `count` key characters. Writers never modify a published table;
+     *          they build a replacement and swap it in.
+     */
+    struct ChildTable {
+        std::size_t count;
+
+        Node** children() { return reinterpret_cast<Node**>(this + 1); }
+        Node* const* children() const { return reinterpret_cast<Node* const*>(this + 1); }
+        char* keys() { return reinterpret_cast<char*>(children() + count); }
+        const char* keys() const { return reinterpret_cast<const char*>(children() + count); }
+
+        static ChildTable* create(std::size_t count) {
+            void* p = ::operator new(sizeof(ChildTable) + count * (sizeof(Node*) + sizeof(char)));
+            return ::new (p) ChildTable{count};
+        }
+
+        static void destroy(const ChildTable* table) {
+            ::operator delete(const_cast<ChildTable*>(table));
+        }
+
+        Node* find(char c) const {
+            const char* first = keys();
+            const char* last = first + count;
+            const char* it = std::lower_bound(first, last, c);
+            return it != last && *it == c ? children()[it - first] : nullptr;
+        }
+    };
+
+    struct Node {
+        /**
+         * @brief Pointer to the object associated with a complete word, or nullptr.
+         * @warning Not owned by the dictionary.
+         */
+        std::atomic<T*> object{nullptr};
+        std::atomic<const ChildTable*> childs{nullptr};
+    };
+
+    /**
+     * @brief Memory unlinked by a writer, waiting until no reader can reach it.
+     */
+    struct Retired {
+        std::uint64_t epoch;
+        const void* pointer;
+        void (*deleter)(const void*);
+    };
+
+    /**
+     * @brief Retired items are reclaimed in batches of at least this many.
+     */
+    static constexpr std::size_t reclaim_threshold = 64;
+
+    Node root;
+    std::mutex write_mutex;
+    std::vector<Retired> retired;
+
+    const Node* find(std::string_view prefix) const {
+        const Node* cur = &root;
+        for (char c : prefix) {
+            const ChildTable* table = cur->childs.load(std::memory_order_acquire);
+            cur = table ? table->find(c) : nullptr;
+            if (!cur) {
+                return nullptr;
+            }
+        }
+        return cur;
+    }
+
+    template<typename Func>
+    static void traverse_recursive(const Node* node, Func &func) {
+        if (T* object = node->object.load(std::memory_order_acquire)) {
+            func(object);
+        }
+        if (const ChildTable* table = node->childs.load(std::memory_order_acquire)) {
+            for (std::size_t i = 0; i < table->count; ++i) {
+                traverse_recursive(table->children()[i], func);
+            }
+        }
+    }
+
+    /**
+     * @brief Frees a node and everything below it. Only safe once unreachable.
+     */
+    static void destroy_subtree(const Node* node) {
+        destroy_table(node->childs.load(std::memory_order_relaxed));
+        delete node;
+    }
+
+    static void destroy_table(const ChildTable* table) {
+        if (table) {
+            for (std::size_t i = 0; i < table->count; ++i) {
+                destroy_subtree(table->children()[i]);
+            }
+            ChildTable::destroy(table);
+        }
+    }
+
+    static void delete_table_only(const void* p) {
+        ChildTable::destroy(static_cast<const ChildTable*>(p));
+    }
+
+    static void delete_node_only(const void* p) {
+        delete static_cast<const Node*>(p);
+    }
+
+    static void delete_table_recursive(const void* p) {
+        destroy_table(static_cast<const ChildTable*>(p));
+    }
+
+    /**
+     * @brief Schedules memory that is no longer reachable from the root for reclamation.
+     * @pre The write mutex is held.
+     */
+    void retire(const void* pointer, void (*deleter)(const void*)) {
+        retired.push_back({EpochDomain::instance().current(), pointer, deleter});
+        if (retired.size() >= reclaim_threshold) {
+            reclaim();
+        }
+    }
+
+    /**
+     * @brief Frees every retired item that no active reader can still reach.
+     * @pre The write mutex is held.
+     */
+    void reclaim() {
+        EpochDomain &domain = EpochDomain::instance();
+        domain.advance();
+        std::uint64_t oldest = domain.oldest_active();
+        auto keep = std::partition(retired.begin(), retired.end(), [oldest](const Retired &r) {
+            return r.epoch >= oldest;
+        });
+        for (auto it = keep; it != retired.end(); ++it) {
+            it->deleter(it->pointer);
+        }
+        retired.erase(keep, retired.end());
+    }
+
+    /**
+     * @brief Publishes a copy of `node`'s child table with `child` added under `c`.
+     * @details `child` is freed if the table cannot be built, and belongs to
+     *          the tree from the moment the table is published.
+     * @pre The write mutex is held and `c` is not present.
+     */
+    void add_child(Node* node, char c, std::unique_ptr<Node> child) {
+        const ChildTable* old = node->childs.load(std::memory_order_relaxed);
+        std::size_t n = old ? old->count : 0;
+        ChildTable* table = ChildTable::create(n + 1);
+        std::size_t pos = old ? static_cast<std::size_t>(std::lower_bound(old->keys(), old->keys() + n, c) - old->keys()) : 0;
+        for (std::size_t i = 0, j = 0; i <= n; ++i) {
+            if (i == pos) {
+                table->keys()[i] = c;
+                table->children()[i] = child.get();
+            } else {
+                table->keys()[i] = old->keys()[j];
+                table->children()[i] = old->children()[j];
+                ++j;
+            }
+        }
+        node->childs.store(table, std::memory_order_release);
+        child.release();
+        if (old) {
+            retire(old, &delete_table_only);
+        }
+    }
+
+    /**
+     * @brief Publishes a copy of `node`'s child table without the entry for `c`.
+     * @pre The write mutex is held and `c` is present.
+     */
+    void remove_child(Node* node, char c) {
+        const ChildTable* old = node->childs.load(std::memory_order_relaxed);
+        ChildTable* table = nullptr;
+        if (old->count > 1) {
+            table = ChildTable::create(old->count - 1);
+            for (std::size_t i = 0, j = 0; i < old->count; ++i) {
+                if (old->keys()[i] != c) {
+                    table->keys()[j] = old->keys()[i];
+                    table->children()[j] = old->children()[i];
+                    ++j;
+                }
+            }
+        }
+        node->childs.store(table, std::memory_order_release);
+        retire(old, &delete_table_only);
+    }
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    ConcurrentDictionary() = default;
+
+    ConcurrentDictionary(const ConcurrentDictionary &) = delete;
+    ConcurrentDictionary &operator=(const ConcurrentDictionary&) = delete;
+
+    /**
+     * @brief Destructor. Frees all nodes, including any still awaiting reclamation.
+     * @pre No other thread is using the dictionary.
+     * @note This does NOT deallocate the `T* object` pointers.
+     */
+    ~ConcurrentDictionary() {
+        for (const Retired &r : retired) {
+            r.deleter(r.pointer);
+        }
+        destroy_table(root.childs.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Inserts a word and associates an object with it. Blocks other writers only.
+     * @note If the word already exists, its associated object pointer will be overwritten.
+     */
+    void insert(T *object, std::string_view word) {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        Node* cur = &root;
+        for (char c : word) {
+            const ChildTable* table = cur->childs.load(std::memory_order_relaxed);
+            Node* child = table ? table->find(c) : nullptr;
+            if (!child) {
+                auto fresh = std::make_unique<Node>();
+                child = fresh.get();
+                add_child(cur, c, std::move(fresh));
+            }
+            cur = child;
+        }
+        cur->object.store(object, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes a word and prunes nodes left without words.
+     * @return True if the word was present.
+     * @note Pruned nodes are freed only after every reader that might see them has finished.
+     */
+    bool erase(std::string_view word) {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        std::vector<Node*> path{&root};
+        for (char c : word) {
+            const ChildTable* table = path.back()->childs.load(std::memory_order_relaxed);
+            Node* child = table ? table->find(c) : nullptr;
+            if (!child) {
+                return false;
+            }
+            path.push_back(child);
+        }
+        if (!path.back()->object.exchange(nullptr, std::memory_order_acq_rel)) {
+            return false;
+        }
+        for (std::size_t depth = word.size(); depth > 0; --depth) {
+            Node* node = path[depth];
+            if (node->object.load(std::memory_order_relaxed) || node->childs.load(std::memory_order_relaxed)) {
+                break;
+            }
+            remove_child(path[depth - 1], word[depth - 1]);
+            retire(node, &delete_node_only);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if a word exists and returns a pointer to its associated object. Wait-free.
+     * @return A pointer to the associated object if the word exists, otherwise nullptr.
+     */
+    T* word_exist(std::string_view word) const {
+        EpochDomain::Guard guard;
+        const Node* node = find(word);
+        return node ? node->object.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief Checks if any word with the given prefix exists. Wait-free.
+     */
+    bool prefix_exist(std::string_view prefix) const {
+        EpochDomain::Guard guard;
+        return find(prefix) != nullptr;
+    }
+
+    /**
+     * @brief Applies a function to each object of a consistent-enough view of the dictionary.
+     * @details Runs without locks. Words inserted or erased concurrently may or
+     *          may not be visited; nodes seen are kept alive until it returns.
+     * @param func Called with a `T*` for each object. Keep it short: memory
+     *             retired meanwhile cannot be reclaimed until the traversal ends.
+     */
+    template<typename Func>
+    void traverse(Func func) const {
+        EpochDomain::Guard guard;
+        traverse_recursive(&root, func);
+    }
+
+    /**
+     * @brief Finds all words with a given prefix (auto-completion). Never blocks on writers.
+     * @param res A vector to which the pointers of matching objects will be added.
+     */
+    void auto_complete(std::string_view prefix, std::vector<T*> &res) const {
+        EpochDomain::Guard guard;
+        if (const Node* node = find(prefix)) {
+            auto collect = [&res](T* obj) {
+                res.push_back(obj);
+            };
+            traverse_recursive(node, collect);
+        }
+    }
+
+    /**
+     * @brief Removes every word. The old nodes are reclaimed once readers release them.
+     * @note This does NOT deallocate the `T* object` pointers themselves.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        root.object.store(nullptr, std::memory_order_release);
+        if (const ChildTable* old = root.childs.exchange(nullptr, std::memory_order_acq_rel)) {
+            retire(old, &delete_table_recursive);
+        }
+        reclaim();
+    }
+};
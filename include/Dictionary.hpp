@@ -1,10 +1,32 @@
 #pragma once
 
-#include <map>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <functional> // For std::function in traverse
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <concepts>
+#include <string_view>
+#include <numeric>
+#include <tuple>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <cstddef>
+#include "NodeAllocator.hpp"
+#include "NodeChildren.hpp"
+#include "FlatTrie.hpp"
+#include "DictionaryInstrumentation.hpp"
 
 /**
  * @file Dictionary.hpp
@@ -13,114 +35,1242 @@
  *       highly efficient for prefix-based operations like auto-complete.
  */
 
-template<class T>
+/**
+ * @brief A range of characters usable as a key without first building a string,
+ *        e.g. `std::span<const char>`, `std::vector<char>` or a `std::views` pipeline.
+ * @details Types that already convert to `std::string_view` are excluded, so
+ *          they keep using the `std::string_view` overloads.
+ */
+template<class R>
+concept KeyCharRange = std::ranges::input_range<const R> &&
+                       std::same_as<std::remove_cv_t<std::ranges::range_value_t<const R>>, char> &&
+                       !std::convertible_to<const R&, std::string_view>;
+
+/**
+ * @brief Selects which matches a bounded `auto_complete` returns.
+ */
+enum class CompletionOrder {
+    /**
+     * @brief The first matches in the order `traverse` visits them.
+     */
+    Lexicographic,
+    /**
+     * @brief The matches with the highest weights, heaviest first.
+     */
+    ByWeight
+};
+
+/**
+ * @brief Value storage policy: words map to `T*` pointers the dictionary does not own.
+ */
+struct ExternalValues {};
+
+/**
+ * @brief Value storage policy: each word's `T` is stored inside its trie node
+ *        and owned by the dictionary.
+ * @details Saves the separate allocation per value and the pointer chase to
+ *          reach it — a hit lands on the node's own storage — at the cost of
+ *          `sizeof(T)` bytes in every node, word-ending or not.
+ */
+struct InlineValues {};
+
+/**
+ * @tparam T The type of the objects associated with words.
+ * @tparam Allocator The node allocation policy (see NodeAllocator.hpp).
+ *         `HeapNodeAllocator` allocates every node separately;
+ *         `ArenaNodeAllocator` packs nodes into blocks owned by the dictionary
+ *         and lets `clear()` drop them all at once.
+ * @tparam Children The child-table policy (see NodeChildren.hpp).
+ *         `MapChildren` keeps each node's children in a `std::map`;
+ *         `AdaptiveChildren` uses ART-style inline/16/48/256-slot tables.
+ *         Both iterate children in the same order, so traversal results
+ *         are identical.
+ * @tparam Storage The value storage policy. With `ExternalValues` (the default)
+ *         words are inserted with a `T*` that the caller keeps alive. With
+ *         `InlineValues` (see `OwningDictionary`) values are moved or
+ *         `emplace`d into the nodes and destroyed with them; every API that
+ *         returns a `T*` then points into the dictionary, valid until that
+ *         word is erased or replaced.
+ */
+template<class T, class Allocator = HeapNodeAllocator,
+         template<class, class> class Children = MapChildren,
+         class Storage = ExternalValues>
 class Dictionary {
+public:
+    /**
+     * @brief The type of the optional per-word weight used for ranked completion.
+     */
+    using weight_type = float;
+
+    /**
+     * @brief True if values live inside the nodes (`InlineValues`).
+     */
+    static constexpr bool owns_values = std::is_same_v<Storage, InlineValues>;
+
 private:
+    struct ValueSlot {
+        // ArenaNodeAllocator only guarantees fundamental alignment for nodes.
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "InlineValues does not support over-aligned value types");
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    struct NoValueSlot {};
+
+    /**
+     * @brief A single trie node.
+     */
+    struct Node {
+        /**
+         * @brief Pointer to the object associated with a complete word.
+         * @details This is nullptr if the node does not represent the end of a word.
+         * @warning With `ExternalValues` the Dictionary class does NOT take ownership
+         *          of this pointer; memory management of the object is the
+         *          responsibility of the user. With `InlineValues` it points into
+         *          `slot` and the value is owned and destroyed by the dictionary.
+         */
+        T* object = nullptr;
+
+        /**
+         * @brief Weight of the word ending here. Meaningful only when `object` is set.
+         */
+        weight_type weight = 0;
+
+        /**
+         * @brief The largest weight of any word in this subtree, or -infinity if none.
+         * @details Cached so ranked completion can skip subtrees that cannot
+         *          improve on what it has already found.
+         */
+        weight_type max_weight = -std::numeric_limits<weight_type>::infinity();
+
+        /**
+         * @brief The number of words in this subtree, including the one ending here.
+         */
+        std::size_t count = 0;
+
+        /**
+         * @brief Table of child nodes, keyed by character.
+         */
+        Children<Node, Allocator> childs;
+
+        /**
+         * @brief Storage for an owned value; `object` points here when it is set.
+         *        Takes no space with `ExternalValues`.
+         */
+        [[no_unique_address]] std::conditional_t<owns_values, ValueSlot, NoValueSlot> slot;
+
+        explicit Node(Allocator &alloc) : childs(alloc) {}
+    };
+
+    /**
+     * @brief The allocator every node of this dictionary is drawn from.
+     * @details Held by pointer so its address survives moving the dictionary:
+     *          child tables may keep a reference to it (see `NodeAllocatorAdapter`).
+     *          Null in a moved-from dictionary until it is written to again.
+     */
+    std::unique_ptr<Allocator> alloc;
+
+    /**
+     * @brief The root node, corresponding to the empty prefix.
+     * @details `empty_root()` while the dictionary has no nodes of its own.
+     */
+    Node* root;
+
+    /**
+     * @brief Scratch buffer for the root-to-node path of the current update.
+     * @details Kept across calls so updates do not allocate once it has grown.
+     */
+    std::vector<Node*> path;
+
+    /**
+     * @brief Allocates and constructs an empty node.
+     */
+    Node* create_node() {
+        DictionaryInstrumentation::node_allocated();
+        void* p = alloc->allocate(sizeof(Node), alignof(Node));
+        return ::new (p) Node(*alloc);
+    }
+
+    /**
+     * @brief The shared root of every dictionary that owns no nodes, e.g. after a move.
+     * @details It is never written, so read paths need not care whether the
+     *          dictionary has a root yet; every update calls `ensure_root` first.
+     */
+    static Node* empty_root() noexcept {
+        static Allocator unused;
+        static Node node(unused);
+        return &node;
+    }
+
+    /**
+     * @brief Gives a dictionary without nodes of its own an allocator and a root.
+     */
+    void ensure_root() {
+        if (root == empty_root()) {
+            if (!alloc) {
+                alloc = std::make_unique<Allocator>();
+            }
+            root = create_node();
+        }
+    }
+
+    /**
+     * @brief Destroys an owned value, if any, and marks the node as not ending a word.
+     */
+    static void reset_value(Node* node) noexcept {
+        if constexpr (owns_values) {
+            if (node->object) {
+                std::destroy_at(node->object);
+            }
+        }
+        node->object = nullptr;
+    }
+
+    /**
+     * @brief Constructs an owned value in `node`, replacing any previous one.
+     * @details A replacement is built aside first and only then moved over the
+     *          old value, so `args` may refer to the value being replaced.
+     * @note If the constructor throws, the node keeps its previous value, if any.
+     */
+    template<class... Args>
+    static void construct_value(Node* node, Args&&... args) {
+        void* bytes = static_cast<void*>(node->slot.bytes);
+        if (!node->object) {
+            node->object = ::new (bytes) T(std::forward<Args>(args)...);
+            return;
+        }
+        T fresh(std::forward<Args>(args)...);
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_move_assignable_v<T>) {
+            reset_value(node);
+            node->object = ::new (bytes) T(std::move(fresh));
+        } else {
+            *node->object = std::move(fresh);
+        }
+    }
+
+    /**
+     * @brief Stores a loaded entry's value: the pointer itself, or a copy of the owned value.
+     */
+    template<class V>
+    static void store_value(Node* node, V &value) {
+        if constexpr (owns_values) {
+            construct_value(node, value);
+        } else {
+            node->object = value;
+        }
+    }
+
+    /**
+     * @brief Destroys the owned values of a subtree without freeing any node.
+     */
+    static void destroy_values(Node* node) noexcept {
+        reset_value(node);
+        for (auto const& [c, child] : node->childs) {
+            destroy_values(child);
+        }
+    }
+
+    /**
+     * @brief Frees every node: drops the arena at once when the allocator allows it.
+     * @details Nodes hold nothing but allocator memory, so skipping their
+     *          destructors is safe; only owned values that need one are visited.
+     */
+    void release_nodes() noexcept {
+        if (root == empty_root()) {
+            return;
+        }
+        if constexpr (Allocator::bulk_release) {
+            if constexpr (owns_values && !std::is_trivially_destructible_v<T>) {
+                destroy_values(root);
+            }
+            alloc->release();
+        } else {
+            destroy_node(root);
+        }
+    }
+
+    /**
+     * @brief Recursively destroys a node and its whole subtree.
+     */
+    void destroy_node(Node* node) noexcept {
+        for (auto const& [c, child] : node->childs) {
+            destroy_node(child);
+        }
+        reset_value(node);
+        node->childs.destroy(*alloc);
+        DictionaryInstrumentation::node_deallocated();
+        node->~Node();
+        alloc->deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    /**
+     * @brief Shrinks the child table of every node in a subtree to fit.
+     */
+    void shrink_recursive(Node* node) {
+        node->childs.shrink_to_fit(*alloc);
+        for (auto const& [c, child] : node->childs) {
+            shrink_recursive(child);
+        }
+    }
+
+    /**
+     * @brief Walks `prefix` down from the root, showing each node on the way to `on_path`.
+     * @param on_path Called as `on_path(depth, node)` for the root (depth 0) and
+     *        every node reached, before the next character is looked up.
+     * @return The node for `prefix`, or nullptr if the walk fell off the trie.
+     */
+    template<class Key, class OnPath>
+    const Node* descend(const Key &prefix, OnPath &&on_path) const {
+        DictionaryInstrumentation::Timer<DictionaryOp::Lookup> timer;
+        const Node* cur = root;
+        std::size_t depth = 0;
+        on_path(depth, cur);
+        for (char c : prefix) {
+            DictionaryInstrumentation::child_probe();
+            cur = cur->childs.find(c);
+            if (!cur) {
+                DictionaryInstrumentation::lookup(depth, false);
+                return nullptr;
+            }
+            DictionaryInstrumentation::node_visit();
+            on_path(++depth, cur);
+        }
+        DictionaryInstrumentation::lookup(depth, true);
+        return cur;
+    }
+
+    /**
+     * @brief Finds the node corresponding to the given prefix (const version).
+     * @tparam Key `std::string_view` or any range of `char`.
+     * @param prefix The prefix to search for.
+     * @return A const pointer to the node if found, otherwise nullptr.
+     */
+    template<class Key>
+    const Node* find(const Key &prefix) const {
+        return descend(prefix, [](std::size_t, const Node*) {});
+    }
+
+    /**
+     * @brief Finds the node corresponding to the given prefix (non-const version).
+     * @param prefix The prefix to search for.
+     * @return A pointer to the node if found, otherwise nullptr.
+     */
+    template<class Key>
+    Node* find(const Key &prefix) {
+        return const_cast<Node*>(static_cast<const Dictionary*>(this)->find(prefix));
+    }
+
+    /**
+     * @brief Walks `word` from the root, creating missing nodes, and records the path.
+     * @return The node for `word`.
+     */
+    template<class Key>
+    Node* descend_creating(const Key &word) {
+        ensure_root();
+        path.clear();
+        Node* cur = root;
+        path.push_back(cur);
+        for (char c : word) {
+            DictionaryInstrumentation::child_probe();
+            Node* child = cur->childs.find(c);
+            if (!child) {
+                child = create_node();
+                cur->childs.insert(c, child, *alloc);
+            }
+            cur = child;
+            path.push_back(cur);
+        }
+        DictionaryInstrumentation::node_visit(path.size() - 1);
+        return cur;
+    }
+
+    /**
+     * @brief Refreshes the cached fields along `path` after the word at its end was set.
+     * @param had_object Whether the word existed before.
+     * @param old_weight Its weight before, if it existed.
+     */
+    void settle_path(bool had_object, weight_type old_weight) {
+        Node* cur = path.back();
+        if ((had_object && cur->weight < old_weight) || !cur->object) {
+            // The old weight may have been the maximum somewhere along the path.
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                update_summary(*it);
+            }
+        } else {
+            std::size_t added = had_object ? 0 : 1;
+            for (Node* node : path) {
+                node->max_weight = std::max(node->max_weight, cur->weight);
+                node->count += added;
+            }
+        }
+    }
+
+    /**
+     * @brief Inserts a word given as `std::string_view` or any range of `char`.
+     */
+    template<class Key>
+    void insert_key(T *object, const Key &word, weight_type weight) {
+        DictionaryInstrumentation::Timer<DictionaryOp::Insert> timer;
+        Node* cur = descend_creating(word);
+        bool had_object = cur->object != nullptr;
+        weight_type old_weight = cur->weight;
+        cur->object = object;
+        cur->weight = weight;
+        settle_path(had_object, old_weight);
+    }
+
+    /**
+     * @brief Constructs an owned value for `word` from `args`, replacing any previous one.
+     */
+    template<class... Args>
+    T* emplace_key(std::string_view word, weight_type weight, Args&&... args) {
+        DictionaryInstrumentation::Timer<DictionaryOp::Insert> timer;
+        Node* cur = descend_creating(word);
+        bool had_object = cur->object != nullptr;
+        weight_type old_weight = cur->weight;
+        try {
+            construct_value(cur, std::forward<Args>(args)...);
+        } catch (...) {
+            // A replaced word keeps its old value; a new one leaves behind
+            // only the nodes created for it, which are dropped.
+            prune_path(word);
+            throw;
+        }
+        cur->weight = weight;
+        settle_path(had_object, old_weight);
+        return cur->object;
+    }
+
+    /**
+     * @brief Recursively gathers all objects in a subtree.
+     * @param node The root of the subtree.
+     * @param res A vector to store the pointers to the found objects.
+     */
+    static void get_all_objects(const Node* node, std::vector<T*> &res) {
+        auto collect = [&res](T* obj) {
+            res.push_back(obj);
+        };
+        traverse_recursive(node, collect);
+    }
+
+    /**
+     * @brief Recursively traverses a subtree and applies a function to each object.
+     * @tparam Func The type of the callable function.
+     * @param node The root of the subtree.
+     * @param func The function to apply to each object pointer.
+     */
+    template<typename Func>
+    static void traverse_recursive(const Node* node, Func &func) {
+        DictionaryInstrumentation::node_visit();
+        if (node->object) {
+            func(node->object);
+        }
+        for (auto const& [key, child] : node->childs) {
+            traverse_recursive(child, func);
+        }
+    }
+
+    /**
+     * @brief Recursively traverses a subtree, passing each object with its key.
+     * @param node The root of the subtree.
+     * @param key The key of `node` on entry; used as the shared buffer for the
+     *            whole descent and restored before returning.
+     * @param func Called with `(std::string_view key, T* object)`.
+     */
+    template<typename Func>
+    static void traverse_keys_recursive(const Node* node, std::string &key, Func &func) {
+        DictionaryInstrumentation::node_visit();
+        if (node->object) {
+            func(std::string_view(key), node->object);
+        }
+        for (auto const& [c, child] : node->childs) {
+            key.push_back(c);
+            traverse_keys_recursive(child, key, func);
+            key.pop_back();
+        }
+    }
+
+    /**
+     * @brief Calls `func(key, node)` for every word-ending node below `node`, in traversal order.
+     */
+    template<typename Func>
+    static void collect_entries(Node* node, std::string &key, Func &func) {
+        if (node->object) {
+            func(std::string_view(key), node);
+        }
+        for (auto const& [c, child] : node->childs) {
+            key.push_back(c);
+            collect_entries(child, key, func);
+            key.pop_back();
+        }
+    }
+
+    /**
+     * @brief Like `traverse_recursive`, but stops as soon as `func` returns false.
+     * @return False if the traversal was stopped early.
+     */
+    template<typename Func>
+    static bool visit_recursive(const Node* node, Func &func) {
+        if (node->object && !func(node->object)) {
+            return false;
+        }
+        for (auto const& [key, child] : node->childs) {
+            if (!visit_recursive(child, func)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Recomputes a node's cached `max_weight` and `count` from itself and its children.
+     */
+    static void update_summary(Node* node) {
+        weight_type best = node->object ? node->weight : -std::numeric_limits<weight_type>::infinity();
+        std::size_t count = node->object ? 1 : 0;
+        for (auto const& [c, child] : node->childs) {
+            best = std::max(best, child->max_weight);
+            count += child->count;
+        }
+        node->max_weight = best;
+        node->count = count;
+    }
+
+    /**
+     * @brief State for one `fuzzy_search` descent.
+     * @details Keeps one Levenshtein row per depth in a single flat buffer, the
+     *          key spelled so far, and the best matches found so far in a
+     *          bounded max-heap. Once the heap is full only strictly better
+     *          matches can enter it, which tightens the pruning threshold.
+     */
+    struct FuzzySearch {
+        std::string_view word;
+        std::size_t max_distance;
+        std::size_t limit;
+        std::vector<std::size_t> rows;
+        std::string key;
+        /**
+         * @brief Candidate matches as `(distance, sequence, word, object)`; the
+         *        sequence number keeps earlier (traversal-order) words on ties.
+         */
+        std::vector<std::tuple<std::size_t, std::size_t, std::string, T*>> heap;
+        std::size_t sequence = 0;
+
+        std::size_t threshold() const {
+            if (heap.size() < limit) {
+                return max_distance;
+            }
+            std::size_t worst = std::get<0>(heap.front());
+            return worst == 0 ? 0 : worst - 1;
+        }
+
+        void offer(std::size_t distance, T* object) {
+            if (heap.size() == limit) {
+                if (distance >= std::get<0>(heap.front())) {
+                    return;
+                }
+                std::pop_heap(heap.begin(), heap.end());
+                heap.pop_back();
+            }
+            heap.emplace_back(distance, sequence++, key, object);
+            std::push_heap(heap.begin(), heap.end());
+        }
+
+        /**
+         * @brief Visits `node`, whose Levenshtein row against `word` is at `rows[depth]`.
+         */
+        void visit(const Node* node, std::size_t depth) {
+            std::size_t n = word.size() + 1;
+            const std::size_t* row = rows.data() + depth * n;
+            if (node->object && row[n - 1] <= threshold()) {
+                offer(row[n - 1], node->object);
+            }
+            if (rows.size() < (depth + 2) * n) {
+                rows.resize((depth + 2) * n);
+                row = rows.data() + depth * n;
+            }
+            std::size_t* next = rows.data() + (depth + 1) * n;
+            for (auto const& [c, child] : node->childs) {
+                next[0] = row[0] + 1;
+                std::size_t best = next[0];
+                for (std::size_t j = 1; j < n; ++j) {
+                    next[j] = std::min({row[j] + 1, next[j - 1] + 1, row[j - 1] + (word[j - 1] != c)});
+                    best = std::min(best, next[j]);
+                }
+                // No extension of this key can come back under the threshold.
+                if (best > threshold()) {
+                    continue;
+                }
+                key.push_back(c);
+                visit(child, depth + 1);
+                key.pop_back();
+                row = rows.data() + depth * n;
+                next = rows.data() + (depth + 1) * n;
+            }
+        }
+    };
+
+    /**
+     * @brief A unit of parallel work: either a whole subtree or one node's own word.
+     */
+    struct Task {
+        const Node* node;
+        bool subtree;
+    };
+
+    /**
+     * @brief Splits the subtree at `node` into at least `target` tasks where possible.
+     * @details Expands subtrees breadth-first, replacing each by its own word and
+     *          its children's subtrees. The result stays in traversal order, so
+     *          concatenating per-task output in task order preserves it.
+     */
+    static std::vector<Task> split_tasks(const Node* node, std::size_t target) {
+        std::vector<Task> tasks{{node, true}};
+        while (tasks.size() < target) {
+            std::vector<Task> next;
+            bool expanded = false;
+            for (const Task &task : tasks) {
+                if (!task.subtree || task.node->childs.empty()) {
+                    next.push_back(task);
+                    continue;
+                }
+                if (task.node->object) {
+                    next.push_back({task.node, false});
+                }
+                for (auto const& [c, child] : task.node->childs) {
+                    next.push_back({child, true});
+                }
+                expanded = true;
+            }
+            tasks.swap(next);
+            if (!expanded) {
+                break;
+            }
+        }
+        return tasks;
+    }
+
+    /**
+     * @brief Runs `body(task_index, worker_index)` for every task on a pool of threads.
+     * @details Workers pull the next unclaimed task from a shared counter, so
+     *          uneven subtrees balance out. The first exception thrown by `body`
+     *          stops the remaining tasks and is rethrown to the caller.
+     */
+    template<typename Body>
+    static void run_tasks(std::size_t count, unsigned threads, Body &body) {
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&](unsigned w) {
+            try {
+                for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                    body(i, w);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(count, std::memory_order_relaxed);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned w = 1; w < threads; ++w) {
+            pool.emplace_back(worker, w);
+        }
+        worker(0);
+        for (std::thread &t : pool) {
+            t.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Resolves a requested thread count; 0 means one per hardware thread.
+     */
+    static unsigned worker_count(unsigned threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        return threads == 0 ? 1 : threads;
+    }
+
+    /**
+     * @brief How many tasks to aim for per worker, to even out skewed subtrees.
+     */
+    static constexpr std::size_t tasks_per_worker = 8;
+
+    /**
+     * @brief Fills `path` with the nodes along `key`, root first.
+     * @return False if `key` leaves the trie; `path` is then incomplete.
+     */
+    bool find_path(std::string_view key) {
+        path.clear();
+        Node* cur = root;
+        path.push_back(cur);
+        for (char c : key) {
+            cur = cur->childs.find(c);
+            if (!cur) {
+                return false;
+            }
+            path.push_back(cur);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Frees the nodes at the bottom of `path` that no longer lead to any
+     *        word, then refreshes the cached fields of the rest of the path.
+     * @param key The key spelled by `path`, used to unlink nodes from their parents.
+     */
+    void prune_path(std::string_view key) {
+        std::size_t depth = path.size() - 1;
+        while (depth > 0 && !path[depth]->object && path[depth]->childs.empty()) {
+            path[depth - 1]->childs.erase(key[depth - 1], *alloc);
+            destroy_node(path[depth]);
+            --depth;
+        }
+        for (std::size_t i = depth + 1; i-- > 0;) {
+            update_summary(path[i]);
+        }
+    }
+
+    /**
+     * @brief Pops `path` down to `depth` entries, finalizing each popped node.
+     * @details A node leaves the path only once no later key in the current
+     *          load passes through it, so its cached fields can be computed
+     *          once, bottom-up, from children that are already final.
+     */
+    void seal_path(std::size_t depth) {
+        while (path.size() > depth) {
+            update_summary(path.back());
+            path.pop_back();
+        }
+    }
+
+    /**
+     * @brief Inserts a sequence of `(key, object)` entries, starting each key
+     *        from the deepest node it shares with the previous one.
+     * @details The sorted-order case visits every node once: nothing on the
+     *          shared path is looked up again, and cached fields are filled in
+     *          bottom-up as nodes are sealed instead of being rescanned per key.
+     *          Unsorted input is still correct, only less efficient.
+     *          If an entry or its value store throws, the entries before it
+     *          stay loaded: the nodes made for the failed key are freed and
+     *          the cached fields of the unsealed path are brought up to date.
+     */
+    template<class Entries, class Place>
+    void load(Entries &&entries, Place place, const weight_type* weights = nullptr) {
+        // The key `path` spells so far, so that it can be pruned on unwind.
+        std::string prev;
+        ensure_root();
+        path.assign(1, root);
+        try {
+            for (auto &&entry : entries) {
+                auto &&[word, value] = entry;
+                std::string_view key(word);
+                std::size_t shared = static_cast<std::size_t>(
+                    std::mismatch(prev.begin(), prev.end(), key.begin(), key.end()).first - prev.begin());
+                seal_path(shared + 1);
+                prev.assign(key);
+                Node* cur = path.back();
+                for (char c : key.substr(shared)) {
+                    Node* child = cur->childs.find(c);
+                    if (!child) {
+                        child = create_node();
+                        try {
+                            cur->childs.insert(c, child, *alloc);
+                        } catch (...) {
+                            destroy_node(child);
+                            throw;
+                        }
+                    }
+                    cur = child;
+                    path.push_back(cur);
+                }
+                place(cur, value);
+                cur->weight = weights ? *weights++ : 0;
+            }
+        } catch (...) {
+            prune_path(prev);
+            throw;
+        }
+        seal_path(0);
+    }
+
+    /**
+     * @brief Collects the `limit` heaviest words under `node`, heaviest first.
+     * @details Best-first search over the cached subtree maxima: a subtree is
+     *          expanded only once its best word outranks everything already
+     *          queued, so the cost is about O(limit log limit) expansions
+     *          rather than the size of the subtree.
+     */
+    static void collect_top(const Node* node, std::size_t limit, std::vector<T*> &res) {
+        struct Entry {
+            weight_type priority;
+            const Node* node;
+            /**
+             * @brief True if this entry stands for the word at `node` rather than its subtree.
+             */
+            bool word;
+            bool operator<(const Entry &other) const { return priority < other.priority; }
+        };
+        std::priority_queue<Entry> queue;
+        queue.push({node->max_weight, node, false});
+        std::size_t found = 0;
+        while (!queue.empty() && found < limit) {
+            Entry top = queue.top();
+            queue.pop();
+            if (top.word) {
+                res.push_back(top.node->object);
+                ++found;
+                continue;
+            }
+            if (top.node->object) {
+                queue.push({top.node->weight, top.node, true});
+            }
+            for (auto const& [c, child] : top.node->childs) {
+                queue.push({child->max_weight, child, false});
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief A lazy forward iterator over the `(key, object)` pairs under a prefix.
+     * @details Entries come out in the same order as `traverse`. The descent is
+     *          kept on an explicit stack rather than the call stack, so iteration
+     *          can be paused at any point and very deep keys cannot overflow.
+     *          The key is assembled in a buffer owned by the iterator; the
+     *          `std::string_view` it yields stays valid until the iterator is
+     *          advanced or destroyed.
+     * @warning Any modification of the dictionary invalidates its iterators.
+     */
+    class PrefixIterator {
+    private:
+        friend class Dictionary;
+        using ChildIterator = typename Children<Node, Allocator>::const_iterator;
+
+        /**
+         * @brief A node whose remaining children are still to be visited.
+         */
+        struct Frame {
+            ChildIterator next;
+            ChildIterator end;
+            /**
+             * @brief Length of the node's key, i.e. where its children's characters go in `key`.
+             */
+            std::size_t depth;
+        };
+
+        std::vector<Frame> stack;
+        std::string key;
+        const Node* current = nullptr;
+
+        void push(const Node* node) {
+            stack.push_back({node->childs.begin(), node->childs.end(), key.size()});
+        }
+
+        /**
+         * @brief Moves to the next node holding an object, or to the end.
+         */
+        void advance() {
+            while (!stack.empty()) {
+                Frame &frame = stack.back();
+                if (frame.next == frame.end) {
+                    stack.pop_back();
+                    continue;
+                }
+                auto [c, child] = *frame.next;
+                ++frame.next;
+                key.resize(frame.depth);
+                key.push_back(c);
+                push(child);
+                if (child->object) {
+                    current = child;
+                    return;
+                }
+            }
+            current = nullptr;
+        }
+
+        /**
+         * @brief Positions the iterator at the first entry of the subtree at `node`.
+         */
+        PrefixIterator(const Node* node, std::string_view prefix) : key(prefix) {
+            if (!node) {
+                return;
+            }
+            push(node);
+            if (node->object) {
+                current = node;
+            } else {
+                advance();
+            }
+        }
+
+        /**
+         * @brief Positions the iterator at the first entry of the subtree at `node`
+         *        whose key comes strictly after `prefix + rest`.
+         * @details Walks down along `rest`; at every level only the children after
+         *          the character taken are left to visit, so they all follow it.
+         */
+        PrefixIterator(const Node* node, std::string_view prefix, std::string_view rest) : key(prefix) {
+            if (!node) {
+                return;
+            }
+            for (char c : rest) {
+                stack.push_back({node->childs.begin(), node->childs.end(), key.size()});
+                Frame &frame = stack.back();
+                while (frame.next != frame.end && !(c < (*frame.next).first)) {
+                    ++frame.next;
+                }
+                node = node->childs.find(c);
+                if (!node) {
+                    advance();
+                    return;
+                }
+                key.push_back(c);
+            }
+            // Everything below the key itself follows it.
+            push(node);
+            advance();
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<std::string_view, T*>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        PrefixIterator() = default;
+
+        value_type operator*() const {
+            return {key, current->object};
+        }
+
+        PrefixIterator &operator++() {
+            advance();
+            return *this;
+        }
+
+        PrefixIterator operator++(int) {
+            PrefixIterator old = *this;
+            advance();
+            return old;
+        }
+
+        bool operator==(const PrefixIterator &other) const {
+            return current == other.current;
+        }
+
+        bool operator==(std::default_sentinel_t) const {
+            return current == nullptr;
+        }
+    };
+
+    /**
+     * @brief An incremental position in the trie, advanced one character at a time.
+     * @details Lets a tokenizer walk the trie while it scans its input, with no
+     *          key buffer at all. A cursor is a single pointer, so saving one
+     *          to backtrack to is free.
+     * @warning Any modification of the dictionary invalidates its cursors.
+     */
+    class Cursor {
+    private:
+        friend class Dictionary;
+        const Node* node = nullptr;
+
+        explicit Cursor(const Node* node) : node(node) {}
+
+    public:
+        Cursor() = default;
+
+        /**
+         * @brief Follows the edge for `c`.
+         * @return False if no stored word continues with `c`; the cursor is then
+         *         invalid and every further step fails.
+         */
+        bool step(char c) {
+            if (node) {
+                node = node->childs.find(c);
+            }
+            return node != nullptr;
+        }
+
+        /**
+         * @brief True while the characters stepped so far are a prefix of some word.
+         */
+        bool valid() const {
+            return node != nullptr;
+        }
+
+        explicit operator bool() const {
+            return valid();
+        }
+
+        /**
+         * @brief The object of the word spelled so far, or nullptr if it is not a word.
+         */
+        T* value() const {
+            return node ? node->object : nullptr;
+        }
+
+        /**
+         * @brief True if some stored word extends the characters stepped so far.
+         */
+        bool can_extend() const {
+            return node && !node->childs.empty();
+        }
+
+        /**
+         * @brief Calls `func(c, child)` with a cursor one step further for every
+         *        edge out of this position, in `std::less<char>` order.
+         */
+        template<typename Func>
+        void for_each_child(Func func) const {
+            if (node) {
+                for (auto const& [c, child] : node->childs) {
+                    func(c, Cursor(child));
+                }
+            }
+        }
+    };
+
     /**
-     * @brief Pointer to the object associated with a complete word.
-     * @details This is nullptr if the node does not represent the end of a word.
-     * @warning The Dictionary class does NOT take ownership of this pointer.
-     *          Memory management of the object is the responsibility of the user.
+     * @brief A view over the entries under a prefix, usable with `std::ranges`
+     *        algorithms and views such as `std::views::take`.
      */
-    T* object = nullptr;
+    class PrefixRange : public std::ranges::view_interface<PrefixRange> {
+    private:
+        friend class Dictionary;
+        const Node* node = nullptr;
+        std::string prefix;
+        /**
+         * @brief If set, the range starts after `prefix + after` (see `entries_after`).
+         */
+        std::string after;
+        bool resume = false;
+
+        PrefixRange(const Node* node, std::string_view prefix, std::string_view after, bool resume)
+            : node(node), prefix(prefix), after(after), resume(resume) {}
+
+    public:
+        PrefixRange() = default;
+
+        PrefixIterator begin() const {
+            return resume ? PrefixIterator(node, prefix, after) : PrefixIterator(node, prefix);
+        }
+
+        std::default_sentinel_t end() const {
+            return std::default_sentinel;
+        }
+    };
 
     /**
-     * @brief Map of child nodes, keyed by character.
+     * @brief Default constructor. The root node is allocated by the first update.
      */
-    std::map<char, Dictionary*> childs;
+    Dictionary() : alloc(std::make_unique<Allocator>()), root(empty_root()) {}
 
     /**
-     * @brief Finds the node corresponding to the given prefix (const version).
-     * @param prefix The prefix to search for.
-     * @return A const pointer to the node if found, otherwise nullptr.
+     * @brief Copy constructor is deleted to prevent shallow copies and double frees.
      */
-    const Dictionary* find(const std::string &prefix) const {
-        const Dictionary* cur = this;
-        for (char c : prefix) {
-            auto it = cur->childs.find(c);
-            if (it == cur->childs.cend()) {
-                return nullptr;
-            }
-            cur = it->second;
-        }
-        return cur;
+    Dictionary(const Dictionary &) = delete;
+
+    /**
+     * @brief Copy assignment operator is deleted to prevent shallow copies.
+     */
+    Dictionary &operator=(const Dictionary&) = delete;
+
+    /**
+     * @brief Move constructor. Takes over the nodes and allocator in O(1).
+     * @details `other` is left empty and fully usable; it allocates a new
+     *          allocator and root only when it is written to again.
+     */
+    Dictionary(Dictionary &&other) noexcept : root(empty_root()) {
+        swap(other);
     }
 
     /**
-     * @brief Finds the node corresponding to the given prefix (non-const version).
-     * @param prefix The prefix to search for.
-     * @return A pointer to the node if found, otherwise nullptr.
+     * @brief Move assignment. Takes over `other`'s nodes and frees this dictionary's.
+     * @details `other` is left empty and fully usable.
      */
-    Dictionary* find(const std::string &prefix) {
-        return const_cast<Dictionary*>(static_cast<const Dictionary*>(this)->find(prefix));
+    Dictionary &operator=(Dictionary &&other) noexcept {
+        if (this != &other) {
+            Dictionary taken(std::move(other));
+            swap(taken);
+        }
+        return *this;
     }
 
     /**
-     * @brief Recursively gathers all objects in this subtree.
-     * @param res A vector to store the pointers to the found objects.
+     * @brief Exchanges the contents of two dictionaries in O(1).
+     * @details Each allocator travels with its nodes, so no node is touched.
      */
-    void get_all_objects(std::vector<T*> &res) const {
-        this->traverse_recursive([&res](T* obj) {
-            res.push_back(obj);
-        });
+    void swap(Dictionary &other) noexcept {
+        std::swap(alloc, other.alloc);
+        std::swap(root, other.root);
+        std::swap(path, other.path);
     }
 
     /**
-     * @brief Recursively traverses the subtree and applies a function to each object.
-     * @tparam Func The type of the callable function.
-     * @param func The function to apply to each object pointer.
+     * @brief Destructor. Frees the memory allocated for child nodes.
+     * @note This does NOT deallocate the `T* object` pointers; owned values
+     *       (`InlineValues`) are destroyed.
      */
-    template<typename Func>
-    void traverse_recursive(Func func) const {
-        if (object) {
-            func(object);
-        }
-        for (auto const& [key, child] : childs) {
-            child->traverse_recursive(func);
-        }
+    ~Dictionary() {
+        release_nodes();
     }
 
-public:
     /**
-     * @brief Default constructor.
+     * @brief Inserts a word into the dictionary and associates an object with it.
+     * @param object A pointer to the object to associate with the word. The Dictionary
+     *               does not take ownership of this pointer.
+     * @param word The word to insert.
+     * @note If the word already exists, its associated object pointer will be overwritten.
      */
-    Dictionary() = default;
+    void insert(T *object, std::string_view word) requires (!owns_values) {
+        insert_key(object, word, 0);
+    }
 
     /**
-     * @brief Copy constructor is deleted to prevent shallow copies and double frees.
+     * @brief Inserts a word given as a range of characters, without building a string.
      */
-    Dictionary(const Dictionary &) = delete;
+    template<KeyCharRange Key>
+    void insert(T *object, const Key &word) requires (!owns_values) {
+        insert_key(object, word, 0);
+    }
 
     /**
-     * @brief Copy assignment operator is deleted to prevent shallow copies.
+     * @brief Inserts a word with a weight for ranked completion.
+     * @param object A pointer to the object to associate with the word. Not owned.
+     * @param word The word to insert.
+     * @param weight The word's rank in `CompletionOrder::ByWeight` completion; higher ranks first.
+     * @note If the word already exists, its object pointer and weight will be overwritten.
      */
-    Dictionary &operator=(const Dictionary&) = delete;
+    void insert(T *object, std::string_view word, weight_type weight) requires (!owns_values) {
+        insert_key(object, word, weight);
+    }
 
     /**
-     * @brief Destructor. Frees the memory allocated for child nodes.
-     * @note This does NOT deallocate the `T* object` pointers.
+     * @brief Moves a value into the dictionary under `word` (`InlineValues` only).
+     * @param word The word to insert.
+     * @param value The value to store; only needs to be move-constructible.
+     * @param weight The word's rank in `CompletionOrder::ByWeight` completion.
+     * @return A pointer to the stored value.
+     * @note If the word already exists, its value is destroyed and replaced.
      */
-    ~Dictionary() {
-        clear();
+    T* insert(std::string_view word, T &&value, weight_type weight = 0) requires owns_values {
+        return emplace_key(word, weight, std::move(value));
     }
 
     /**
-     * @brief Inserts a word into the dictionary and associates an object with it.
-     * @param object A pointer to the object to associate with the word. The Dictionary
-     *               does not take ownership of this pointer.
+     * @brief Constructs a value in place under `word` (`InlineValues` only).
      * @param word The word to insert.
-     * @note If the word already exists, its associated object pointer will be overwritten.
+     * @param args The arguments forwarded to `T`'s constructor.
+     * @return A pointer to the stored value.
+     * @note If the word already exists, its value is replaced; `args` may refer to it.
+     *       If the constructor throws, the dictionary is unchanged.
      */
-    void insert(T *object, const std::string &word) {
-        Dictionary* cur = this;
-        for (char c : word) {
-            Dictionary* &child = cur->childs[c];
-            if (!child) {
-                child = new Dictionary;
-            }
-            cur = child;
+    template<class... Args>
+    T* emplace(std::string_view word, Args&&... args) requires owns_values {
+        return emplace_key(word, 0, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts many words at once.
+     * @details The entries are ordered by key internally (stably, so later
+     *          duplicates still win) and then loaded as with `load_sorted`, so
+     *          keys sharing a prefix reuse the path instead of walking from the root.
+     *          Keys are ordered by `std::less<char>`, like the children of a node,
+     *          so bytes above 0x7F do not break up runs of shared prefixes.
+     * @tparam Entries A random-access range of pair-like `(key, T*)` elements,
+     *         e.g. `std::span<const std::pair<std::string_view, T*>>`; with
+     *         `InlineValues`, `(key, T)` elements whose values are copied in.
+     * @param entries The words and their associated objects.
+     */
+    template<std::ranges::random_access_range Entries>
+    void insert_batch(const Entries &entries) {
+        std::vector<std::size_t> order(std::ranges::size(entries));
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        auto key_of = [&entries](std::size_t i) {
+            auto &&[word, object] = entries[i];
+            return std::string_view(word);
+        };
+        std::stable_sort(order.begin(), order.end(), [&key_of](std::size_t a, std::size_t b) {
+            return std::ranges::lexicographical_compare(key_of(a), key_of(b));
+        });
+        load(order | std::views::transform([&entries](std::size_t i) -> decltype(auto) {
+            return entries[i];
+        }), [](Node* node, auto &value) { store_value(node, value); });
+    }
+
+    /**
+     * @brief Bulk-loads a stream of entries that is already sorted by key.
+     * @details Each key continues from the node it shares with the previous key,
+     *          and per-node bookkeeping is done once per node, bottom-up, as the
+     *          loader leaves it. This is the fastest way to build a dictionary
+     *          from a sorted word list.
+     * @tparam Entries An input range of pair-like `(key, T*)` elements, or with
+     *         `InlineValues` `(key, T)` elements to copy in; may be single-pass.
+     * @param entries The words and their associated objects, in lexicographic
+     *        order of `char`s (`std::less<char>`, as in `traverse`). With
+     *        `InlineValues`, values are moved out of a container passed as an
+     *        rvalue instead of being copied; views are always copied from.
+     * @note Unsorted input is inserted correctly, just without the speed-up.
+     */
+    template<std::ranges::input_range Entries>
+    void load_sorted(Entries &&entries) {
+        if constexpr (owns_values && !std::is_lvalue_reference_v<Entries> &&
+                      !std::ranges::view<std::remove_cvref_t<Entries>>) {
+            load(entries, [](Node* node, auto &value) { construct_value(node, std::move(value)); });
+        } else {
+            load(entries, [](Node* node, auto &value) { store_value(node, value); });
         }
-        cur->object = object;
+    }
+
+    /**
+     * @brief Removes a word, freeing the nodes that no longer lead to any word.
+     * @details Freed nodes go back to the allocator, so with `ArenaNodeAllocator`
+     *          they are recycled by later inserts; memory follows the live key
+     *          count rather than growing with churn.
+     * @param word The word to remove.
+     * @return True if the word was present.
+     * @note This does NOT deallocate the associated object; an owned value is destroyed.
+     */
+    bool erase(std::string_view word) {
+        if (!find_path(word) || !path.back()->object) {
+            return false;
+        }
+        reset_value(path.back());
+        prune_path(word);
+        return true;
+    }
+
+    /**
+     * @brief Removes every word starting with `prefix`, freeing their whole subtree.
+     * @param prefix The prefix to remove. An empty prefix clears the dictionary.
+     * @return The number of words removed.
+     * @note This does NOT deallocate the associated objects; owned values are destroyed.
+     */
+    std::size_t erase_prefix(std::string_view prefix) {
+        if (!find_path(prefix)) {
+            return 0;
+        }
+        std::size_t removed = path.back()->count;
+        if (prefix.empty()) {
+            clear();
+            return removed;
+        }
+        Node* node = path.back();
+        path.pop_back();
+        path.back()->childs.erase(prefix.back(), *alloc);
+        destroy_node(node);
+        prune_path(prefix.substr(0, prefix.size() - 1));
+        return removed;
     }
 
     /**
@@ -128,7 +1278,7 @@ public:
      * @param word The word to search for.
      * @return A pointer to the associated object if the word exists, otherwise nullptr.
      */
-    T* word_exist(const std::string &word) {
+    T* word_exist(std::string_view word) {
         return const_cast<T*>(static_cast<const Dictionary*>(this)->word_exist(word));
     }
 
@@ -137,20 +1287,256 @@ public:
      * @param word The word to search for.
      * @return A const pointer to the associated object if the word exists, otherwise nullptr.
      */
-    const T* word_exist(const std::string &word) const {
-        const Dictionary *cur = find(word);
+    const T* word_exist(std::string_view word) const {
+        const Node *cur = find(word);
         return cur && cur->object ? cur->object : nullptr;
     }
 
+    /**
+     * @brief Checks if a word given as a range of characters exists.
+     */
+    template<KeyCharRange Key>
+    T* word_exist(const Key &word) {
+        Node *cur = find(word);
+        return cur ? cur->object : nullptr;
+    }
+
+    /**
+     * @brief Checks if a word given as a range of characters exists (const version).
+     */
+    template<KeyCharRange Key>
+    const T* word_exist(const Key &word) const {
+        const Node *cur = find(word);
+        return cur ? cur->object : nullptr;
+    }
+
     /**
      * @brief Checks if any word with the given prefix exists.
      * @param prefix The prefix to check.
      * @return True if the prefix exists, false otherwise.
      */
-    bool prefix_exist(const std::string &prefix) const {
+    bool prefix_exist(std::string_view prefix) const {
+        return find(prefix) != nullptr;
+    }
+
+    /**
+     * @brief Checks if any word starts with a prefix given as a range of characters.
+     */
+    template<KeyCharRange Key>
+    bool prefix_exist(const Key &prefix) const {
         return find(prefix) != nullptr;
     }
 
+    /**
+     * @brief Finds the longest stored word that is a prefix of `input`.
+     * @details One walk down `input`, remembering the last word passed, instead
+     *          of a `word_exist` per prefix. The empty word matches if stored.
+     * @return The length of the matching word and its object, or `std::nullopt`
+     *         if no stored word is a prefix of `input`.
+     */
+    std::optional<std::pair<std::size_t, T*>> longest_prefix_match(std::string_view input) const {
+        std::optional<std::pair<std::size_t, T*>> best;
+        descend(input, [&best](std::size_t depth, const Node* node) {
+            if (node->object) {
+                best.emplace(depth, node->object);
+            }
+        });
+        return best;
+    }
+
+    /**
+     * @brief Calls a function for every stored word that is a prefix of `input`, shortest first.
+     * @details Done in one walk down `input`, e.g. for tokenizers that try all
+     *          dictionary words starting at a position.
+     * @param func Called as `func(std::string_view word, T* object)`, where
+     *        `word` is a prefix of `input`.
+     */
+    template<typename Func>
+    void for_each_prefix_of(std::string_view input, Func func) const {
+        descend(input, [&](std::size_t depth, const Node* node) {
+            if (node->object) {
+                func(input.substr(0, depth), node->object);
+            }
+        });
+    }
+
+    /**
+     * @brief A structural and memory breakdown of the dictionary, from `memory_stats`.
+     */
+    struct MemoryStats {
+        std::size_t node_count = 0;
+        /**
+         * @brief Parent-child links; `node_count - 1`, or 0 while there is no root node.
+         */
+        std::size_t edge_count = 0;
+        std::size_t word_count = 0;
+        /**
+         * @brief `depth_histogram[d]` is the number of nodes `d` characters below the root.
+         */
+        std::vector<std::size_t> depth_histogram;
+        /**
+         * @brief `fanout_histogram[k]` is the number of nodes with exactly `k` children.
+         */
+        std::vector<std::size_t> fanout_histogram;
+
+        /**
+         * @brief `sizeof(Node)` for every node.
+         */
+        std::size_t node_bytes = 0;
+        /**
+         * @brief Storage the child tables hold outside their nodes (see `Children::table_bytes`).
+         */
+        std::size_t child_table_bytes = 0;
+        /**
+         * @brief The reusable update path buffer.
+         */
+        std::size_t scratch_bytes = 0;
+        /**
+         * @brief Memory the allocator holds beyond live nodes and tables: free
+         *        lists, rounding and unused block tails. Zero for allocators
+         *        that do not report `bytes_reserved()`.
+         */
+        std::size_t allocator_slack_bytes = 0;
+        /**
+         * @brief All of the above plus the dictionary object itself.
+         */
+        std::size_t total_bytes = 0;
+    };
+
+    /**
+     * @brief A word found by `fuzzy_search`.
+     */
+    struct FuzzyMatch {
+        std::string word;
+        T* object;
+        /**
+         * @brief The Levenshtein distance from the query.
+         */
+        std::size_t distance;
+    };
+
+    /**
+     * @brief Finds stored words within a given edit distance of `word`.
+     * @details Walks the trie once, carrying one row of the Levenshtein matrix
+     *          down each branch; a branch is abandoned as soon as the smallest
+     *          entry of its row exceeds the threshold, so only a small part of
+     *          the trie is visited for small distances.
+     * @param word The query.
+     * @param max_distance The largest Levenshtein distance (insertions,
+     *                     deletions and substitutions) to accept.
+     * @param limit The maximum number of matches to return.
+     * @return The closest matches, sorted by distance; ties in traversal order.
+     */
+    std::vector<FuzzyMatch> fuzzy_search(std::string_view word, std::size_t max_distance,
+                                         std::size_t limit = std::numeric_limits<std::size_t>::max()) const {
+        std::vector<FuzzyMatch> res;
+        if (limit == 0) {
+            return res;
+        }
+        FuzzySearch search{word, max_distance, limit, {}, {}, {}};
+        search.rows.resize(word.size() + 1);
+        std::iota(search.rows.begin(), search.rows.end(), std::size_t{0});
+        search.visit(root, 0);
+        std::sort_heap(search.heap.begin(), search.heap.end());
+        res.reserve(search.heap.size());
+        for (auto &[distance, sequence, key, object] : search.heap) {
+            res.push_back({std::move(key), object, distance});
+        }
+        return res;
+    }
+
+    /**
+     * @brief Returns a cursor at the root, for walking the trie one character at a time.
+     */
+    Cursor cursor() const {
+        return Cursor(root);
+    }
+
+    /**
+     * @brief The number of words in the dictionary. O(1).
+     */
+    std::size_t size() const {
+        return root->count;
+    }
+
+    /**
+     * @brief True if the dictionary holds no words.
+     */
+    bool empty() const {
+        return root->count == 0;
+    }
+
+    /**
+     * @brief The number of words starting with `prefix`, without visiting them.
+     * @return O(|prefix|) using the per-node subtree counts.
+     */
+    std::size_t count_prefix(std::string_view prefix) const {
+        const Node* node = find(prefix);
+        return node ? node->count : 0;
+    }
+
+    /**
+     * @brief Finds the `k`-th word (0-based) starting with `prefix`, in `traverse` order.
+     * @details Skips whole subtrees using their counts, so the cost depends on
+     *          the key length and fan-out rather than on `k`.
+     * @return The word and its object, or `std::nullopt` if fewer than `k + 1` words match.
+     */
+    std::optional<std::pair<std::string, T*>> nth_word(std::string_view prefix, std::size_t k) const {
+        const Node* node = find(prefix);
+        if (!node || k >= node->count) {
+            return std::nullopt;
+        }
+        std::string word(prefix);
+        while (true) {
+            if (node->object) {
+                if (k == 0) {
+                    return std::make_pair(std::move(word), node->object);
+                }
+                --k;
+            }
+            for (auto const& [c, child] : node->childs) {
+                if (k < child->count) {
+                    word.push_back(c);
+                    node = child;
+                    break;
+                }
+                k -= child->count;
+            }
+        }
+    }
+
+    /**
+     * @brief The number of stored words that come strictly before `word` in `traverse` order.
+     * @details `word` need not be stored. Together with `nth_word` this gives
+     *          offset-based pagination: `nth_word("", rank(w))` is the first
+     *          word not before `w`.
+     */
+    std::size_t rank(std::string_view word) const {
+        std::size_t before = 0;
+        const Node* node = root;
+        for (char c : word) {
+            // The word ending here is a proper prefix of `word`, hence before it.
+            if (node->object) {
+                ++before;
+            }
+            const Node* next = nullptr;
+            for (auto const& [key, child] : node->childs) {
+                if (!(key < c)) {
+                    if (key == c) {
+                        next = child;
+                    }
+                    break;
+                }
+                before += child->count;
+            }
+            if (!next) {
+                return before;
+            }
+            node = next;
+        }
+        return before;
+    }
+
     /**
      * @brief Traverses the entire dictionary and applies a function to each object.
      * @tparam Func The type of the callable function (e.g., a lambda).
@@ -158,7 +1544,99 @@ public:
      */
     template<typename Func>
     void traverse(Func func) const {
-        this->traverse_recursive(func);
+        DictionaryInstrumentation::Timer<DictionaryOp::Traverse> timer;
+        traverse_recursive(root, func);
+    }
+
+    /**
+     * @brief Traverses the entire dictionary, passing each object with its word.
+     * @tparam Func The type of the callable function.
+     * @param func Called with `(std::string_view word, T* object)`. The view
+     *             points into a buffer reused for the whole traversal, so it is
+     *             only valid during the call; copy it to keep it.
+     */
+    template<typename Func>
+    void traverse_with_keys(Func func) const {
+        DictionaryInstrumentation::Timer<DictionaryOp::Traverse> timer;
+        std::string key;
+        traverse_keys_recursive(root, key, func);
+    }
+
+    /**
+     * @brief Finds all words with a given prefix, passing each one with its object.
+     * @param prefix The prefix to search for.
+     * @param func Called with `(std::string_view word, T* object)` for each
+     *             match, in `traverse` order. The view is only valid during the call.
+     */
+    template<typename Func>
+    void auto_complete_with_keys(std::string_view prefix, Func func) const {
+        const Node* node = find(prefix);
+        if (node) {
+            std::string key(prefix);
+            traverse_keys_recursive(node, key, func);
+        }
+    }
+
+    /**
+     * @brief Traverses the entire dictionary on several threads.
+     * @details The tree is split into subtrees that workers claim dynamically,
+     *          so a few large subtrees do not leave the other threads idle.
+     * @tparam Func The type of the callable function.
+     * @param func Called with a `T*` for each object, concurrently from several
+     *             threads and in no particular order; it must be thread-safe.
+     * @param threads The number of threads to use; 0 selects one per hardware thread.
+     * @throws Rethrows the first exception thrown by `func`, after all threads stop.
+     */
+    template<typename Func>
+    void parallel_traverse(Func func, unsigned threads = 0) const {
+        threads = worker_count(threads);
+        std::vector<Task> tasks = split_tasks(root, threads * tasks_per_worker);
+        auto body = [&](std::size_t i, unsigned) {
+            if (tasks[i].subtree) {
+                traverse_recursive(tasks[i].node, func);
+            } else {
+                func(tasks[i].node->object);
+            }
+        };
+        run_tasks(tasks.size(), threads, body);
+    }
+
+    /**
+     * @brief Finds all words with a given prefix using several threads.
+     * @param prefix The prefix to search for.
+     * @param res A vector to which the pointers of matching objects will be added.
+     * @param ordered If true, results are in the same order as `auto_complete`;
+     *                otherwise per-thread buffers are merged in whatever order
+     *                the work happened to be split.
+     * @param threads The number of threads to use; 0 selects one per hardware thread.
+     */
+    void parallel_auto_complete(std::string_view prefix, std::vector<T*> &res,
+                                bool ordered = true, unsigned threads = 0) const {
+        const Node* node = find(prefix);
+        if (!node) {
+            return;
+        }
+        threads = worker_count(threads);
+        std::vector<Task> tasks = split_tasks(node, threads * tasks_per_worker);
+        // One buffer per task keeps traversal order; one per worker is enough otherwise.
+        std::vector<std::vector<T*>> buffers(ordered ? tasks.size() : threads);
+        auto body = [&](std::size_t i, unsigned w) {
+            std::vector<T*> &out = buffers[ordered ? i : w];
+            if (tasks[i].subtree) {
+                get_all_objects(tasks[i].node, out);
+            } else {
+                out.push_back(tasks[i].node->object);
+            }
+        };
+        run_tasks(tasks.size(), threads, body);
+        std::size_t total = res.size();
+        for (const auto &buffer : buffers) {
+            total += buffer.size();
+        }
+        res.reserve(total);
+        for (const auto &buffer : buffers) {
+            res.insert(res.end(), buffer.begin(), buffer.end());
+        }
     }
 
     /**
@@ -166,22 +1644,260 @@ public:
      * @param prefix The prefix to search for.
      * @param res A vector to which the pointers of matching objects will be added.
      */
-    void auto_complete(const std::string &prefix, std::vector<T*> &res) const {
-        const Dictionary* root = find(prefix);
-        if (root) {
-            root->get_all_objects(res);
+    void auto_complete(std::string_view prefix, std::vector<T*> &res) const {
+        const Node* node = find(prefix);
+        if (node) {
+            get_all_objects(node, res);
         }
     }
 
     /**
-     * @brief Clears the dictionary, deallocating all nodes.
-     * @note This does NOT deallocate the `T* object` pointers themselves.
+     * @brief Finds all words with a prefix given as a range of characters.
+     */
+    template<KeyCharRange Key>
+    void auto_complete(const Key &prefix, std::vector<T*> &res) const {
+        const Node* node = find(prefix);
+        if (node) {
+            get_all_objects(node, res);
+        }
+    }
+
+    /**
+     * @brief Finds at most `limit` words with a given prefix.
+     * @param prefix The prefix to search for.
+     * @param res A vector to which the pointers of matching objects will be added.
+     * @param limit The maximum number of objects to add.
+     * @param order `Lexicographic` stops after the first `limit` matches in
+     *              traversal order; `ByWeight` returns the `limit` heaviest
+     *              matches (see the weighted `insert`), heaviest first. Words of
+     *              equal weight come out in unspecified order.
+     * @note Neither order visits the whole subtree under `prefix`.
+     */
+    void auto_complete(std::string_view prefix, std::vector<T*> &res, std::size_t limit,
+                       CompletionOrder order = CompletionOrder::Lexicographic) const {
+        const Node* node = find(prefix);
+        if (!node || limit == 0) {
+            return;
+        }
+        if (order == CompletionOrder::ByWeight) {
+            collect_top(node, limit, res);
+            return;
+        }
+        std::size_t found = 0;
+        auto collect = [&](T* obj) {
+            res.push_back(obj);
+            return ++found < limit;
+        };
+        visit_recursive(node, collect);
+    }
+
+    /**
+     * @brief Lazily enumerates the `(key, object)` pairs of all words with a given prefix.
+     * @param prefix The prefix to enumerate.
+     * @return A forward range in `traverse` order; empty if no word has the prefix.
+     */
+    PrefixRange entries(std::string_view prefix = "") const {
+        return PrefixRange(find(prefix), prefix, "", false);
+    }
+
+    /**
+     * @brief Resumes an enumeration after a previously returned key.
+     * @details Intended for cursor-style pagination: pass the last key of the
+     *          previous page to get the following entries. `last_key` need not
+     *          be stored in the dictionary.
+     * @param prefix The prefix being enumerated.
+     * @param last_key A key starting with `prefix`; the range begins strictly after it.
+     * @return A forward range of the remaining entries under `prefix`.
+     */
+    PrefixRange entries_after(std::string_view prefix, std::string_view last_key) const {
+        if (last_key.compare(0, prefix.size(), prefix) != 0) {
+            // Not under the prefix: either everything or nothing follows it.
+            bool before = std::lexicographical_compare(last_key.begin(), last_key.end(),
+                                                       prefix.begin(), prefix.end());
+            return before ? entries(prefix) : PrefixRange();
+        }
+        return PrefixRange(find(prefix), prefix, std::string_view(last_key).substr(prefix.size()), true);
+    }
+
+    /**
+     * @brief Serializes the dictionary into a pointer-free trie image (see FlatTrie.hpp).
+     * @tparam Encode A callable taking `const T&` and returning a trivially copyable value.
+     * @param encode Converts each stored object into the value kept in the image.
+     * @return The image bytes, readable in place by `MappedDictionary`.
+     */
+    template<typename Encode>
+    std::vector<char> freeze(Encode encode) const {
+        using V = std::decay_t<decltype(encode(std::declval<const T&>()))>;
+        FlatTrieBuilder<V> builder;
+        // Breadth-first order makes the children of every node contiguous.
+        std::vector<const Node*> order{root};
+        builder.add_node('\0');
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const Node* node = order[i];
+            builder.set_children(i, order.size(), node->childs.size());
+            if (node->object) {
+                builder.set_value(i, encode(*node->object));
+            }
+            for (auto const& [c, child] : node->childs) {
+                order.push_back(child);
+                builder.add_node(c);
+            }
+        }
+        return builder.finish();
+    }
+
+    /**
+     * @brief Serializes the dictionary, copying each object into the image.
+     * @note Requires `T` to be trivially copyable.
+     */
+    std::vector<char> freeze() const {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "freeze() without an encoder requires a trivially copyable T");
+        return freeze([](const T &object) { return object; });
+    }
+
+    /**
+     * @brief Writes the trie image to a file for `MappedDictionary` to map.
+     * @param path The output file.
+     * @param encode Converts each stored object into the value kept in the image.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template<typename Encode>
+    void save(const std::string &path, Encode encode) const {
+        write_flat_trie(path, freeze(encode));
+    }
+
+    /**
+     * @brief Writes the trie image to a file, copying each object into it.
+     * @note Requires `T` to be trivially copyable.
+     */
+    void save(const std::string &path) const {
+        write_flat_trie(path, freeze());
+    }
+
+    /**
+     * @brief Walks the whole trie and reports its shape and memory footprint.
+     * @details O(number of nodes). `std::map` entries are costed from the
+     *          tree-node layout, so `MapChildren` figures are close estimates
+     *          that leave out the heap's own per-allocation headers.
+     */
+    MemoryStats memory_stats() const {
+        MemoryStats stats;
+        stats.fanout_histogram.assign(257, 0);
+        std::vector<std::pair<const Node*, std::size_t>> stack;
+        if (root != empty_root()) {
+            stack.emplace_back(root, 0);
+        }
+        while (!stack.empty()) {
+            auto [node, depth] = stack.back();
+            stack.pop_back();
+            ++stats.node_count;
+            if (depth >= stats.depth_histogram.size()) {
+                stats.depth_histogram.resize(depth + 1, 0);
+            }
+            ++stats.depth_histogram[depth];
+            ++stats.fanout_histogram[node->childs.size()];
+            stats.child_table_bytes += node->childs.table_bytes();
+            for (auto const& [c, child] : node->childs) {
+                stack.emplace_back(child, depth + 1);
+            }
+        }
+        while (stats.fanout_histogram.size() > 1 && stats.fanout_histogram.back() == 0) {
+            stats.fanout_histogram.pop_back();
+        }
+        stats.edge_count = stats.node_count ? stats.node_count - 1 : 0;
+        stats.word_count = root->count;
+        stats.node_bytes = stats.node_count * sizeof(Node);
+        stats.scratch_bytes = path.capacity() * sizeof(Node*);
+        if constexpr (requires { alloc->bytes_reserved(); }) {
+            std::size_t live = stats.node_bytes + stats.child_table_bytes;
+            std::size_t reserved = alloc ? alloc->bytes_reserved() : 0;
+            stats.allocator_slack_bytes = reserved > live ? reserved - live : 0;
+        }
+        stats.total_bytes = sizeof(*this) + sizeof(Allocator) + stats.node_bytes + stats.child_table_bytes +
+                            stats.scratch_bytes + stats.allocator_slack_bytes;
+        return stats;
+    }
+
+    /**
+     * @brief The total bytes used by the dictionary; `memory_stats().total_bytes`.
+     */
+    std::size_t memory_usage() const {
+        return memory_stats().total_bytes;
+    }
+
+    /**
+     * @brief Shrinks every child table to the smallest layout for its fan-out, in place.
+     * @details Undoes the hysteresis `AdaptiveChildren` keeps after erasures,
+     *          and drops the spare capacity of the update path buffer.
+     */
+    void shrink_to_fit() {
+        if (root != empty_root()) {
+            shrink_recursive(root);
+        }
+        path.shrink_to_fit();
+    }
+
+    /**
+     * @brief Rebuilds the trie into its densest representation after heavy churn.
+     * @details With a bulk-release allocator every word, object and weight is
+     *          copied out (owned values are moved), the arena is dropped, and the words are reloaded in
+     *          order: nodes end up packed contiguously in traversal order, with
+     *          no free-listed or oversized blocks left behind. Other allocators
+     *          already return freed nodes to the heap, so this is `shrink_to_fit()`.
+     * @note Rebuilding needs temporary memory for a copy of every key. If an
+     *       allocation fails part-way, the dictionary is left holding the
+     *       words reloaded so far.
      */
-    void clear() {
-        for (auto &[c, child] : childs) {
-            delete child;
-            child = nullptr;
+    void compact() {
+        if constexpr (Allocator::bulk_release) {
+            using Value = std::conditional_t<owns_values, T, T*>;
+            std::vector<std::pair<std::string, Value>> entries;
+            std::vector<weight_type> weights;
+            entries.reserve(root->count);
+            weights.reserve(root->count);
+            std::string key;
+            auto take = [&entries, &weights](std::string_view word, Node* node) {
+                if constexpr (owns_values) {
+                    entries.emplace_back(word, std::move(*node->object));
+                } else {
+                    entries.emplace_back(word, node->object);
+                }
+                weights.push_back(node->weight);
+            };
+            collect_entries(root, key, take);
+            release_nodes();
+            root = empty_root();
+            path.clear();
+            path.shrink_to_fit();
+            load(entries, [](Node* node, Value &value) {
+                if constexpr (owns_values) {
+                    construct_value(node, std::move(value));
+                } else {
+                    node->object = value;
+                }
+            }, weights.data());
+        } else {
+            shrink_to_fit();
         }
-        childs.clear();
+    }
+
+    /**
+     * @brief Clears the dictionary, deallocating all nodes.
+     * @details With a bulk-release allocator the whole arena is dropped at once
+     *          instead of visiting every node.
+     * @note This does NOT deallocate the `T* object` pointers themselves;
+     *       owned values are destroyed.
+     */
+    void clear() noexcept {
+        release_nodes();
+        root = empty_root();
     }
 };
+
+/**
+ * @brief A Dictionary that stores and owns its values inline (`InlineValues`).
+ */
+template<class T, class Allocator = HeapNodeAllocator,
+         template<class, class> class Children = MapChildren>
+using OwningDictionary = Dictionary<T, Allocator, Children, InlineValues>;
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "input_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file DictionaryIngest.hpp
+ * @brief Bulk-loads a word list from a stream into a Dictionary through a two-stage pipeline.
+ * @details A reader thread pulls the input in large blocks, splits it into
+ *          words, validates them and sorts each chunk; meanwhile the calling
+ *          thread hands the previous sorted chunk to the dictionary's
+ *          `load_sorted`, which continues each key from the path it shares
+ *          with the one before. Compared with `read_validated_input<std::string>`
+ *          plus `insert` per word, there is no per-word getline, stream or
+ *          string, and no walk from the root for every key.
+ *
+ * @code
+ * OwningDictionary<int> dict;
+ * IngestStats stats = ingest_words(std::cin, dict, [](std::string_view) { return 1; });
+ * std::cerr << stats << '\n';
+ * @endcode
+ */
+
+/**
+ * @brief Tuning knobs for `ingest_words`.
+ */
+struct IngestOptions {
+    /**
+     * @brief Words per chunk handed from the reader to the builder.
+     */
+    std::size_t chunk_words = 1 << 16;
+    /**
+     * @brief Chunks that may wait between the stages before the reader pauses.
+     */
+    std::size_t queue_depth = 4;
+    /**
+     * @brief Bytes read from the stream at a time.
+     */
+    std::size_t block_bytes = 1 << 16;
+};
+
+/**
+ * @brief What an `ingest_words` run did, and how fast.
+ */
+struct IngestStats {
+    std::size_t bytes = 0;
+    /**
+     * @brief The words loaded, counting repeats (the last value of a repeated word wins).
+     */
+    std::size_t words = 0;
+    /**
+     * @brief The words the validator rejected.
+     */
+    std::size_t rejected = 0;
+    std::size_t chunks = 0;
+    /**
+     * @brief Wall-clock time of the whole run.
+     */
+    std::chrono::duration<double> elapsed{};
+    /**
+     * @brief Time the builder spent loading chunks, excluding waits for the reader.
+     */
+    std::chrono::duration<double> build_time{};
+
+    double words_per_second() const {
+        return elapsed.count() > 0 ? static_cast<double>(words) / elapsed.count() : 0.0;
+    }
+
+    double megabytes_per_second() const {
+        return elapsed.count() > 0 ? static_cast<double>(bytes) / 1e6 / elapsed.count() : 0.0;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const IngestStats &stats) {
+        return out << stats.words << " words (" << stats.rejected << " rejected) from "
+                   << stats.bytes << " bytes in " << stats.elapsed.count() << " s: "
+                   << stats.words_per_second() << " words/s, "
+                   << stats.megabytes_per_second() << " MB/s, "
+                   << stats.build_time.count() << " s building";
+    }
+};
+
+/**
+ * @brief Streams whitespace-separated words into a dictionary, reading and building in parallel.
+ * @tparam Dict A dictionary with `load_sorted`, e.g. `Dictionary<T>` or `OwningDictionary<T>`.
+ * @param in The word list; read to end of input.
+ * @param dict The dictionary to add the words to; only touched by the calling thread.
+ * @param value_for Called with each word, on the builder thread, to get what
+ *        the dictionary stores for it: a `T*` for `Dictionary<T>`, a `T` for `OwningDictionary<T>`.
+ * @param validator Returns true for words to keep, e.g. `validators::length_between(1, 64)`.
+ *        Called with a `std::string_view` on the reader thread. If nullptr, every word is kept.
+ * @param options Chunk and buffer sizes.
+ * @return The counts and throughput of the run.
+ * @throws Whatever reading, `value_for` or the dictionary throws, after the
+ *         reader thread has stopped. Chunks loaded before the error stay in `dict`.
+ */
+template<class Dict, class ValueFor, InputValidator<std::string_view> Validator = std::nullptr_t>
+IngestStats ingest_words(std::istream &in, Dict &dict, ValueFor value_for,
+                         const Validator &validator = nullptr, const IngestOptions &options = {}) {
+    using clock = std::chrono::steady_clock;
+    static constexpr std::string_view spaces = " \t\n\v\f\r";
+
+    // Words are packed into one buffer per chunk and referred to by offset, not
+    // by view: moving a short string relocates its characters, so views are
+    // only made by the builder once the chunk has stopped moving.
+    struct Chunk {
+        std::string chars;
+        std::vector<std::pair<std::size_t, std::size_t>> spans;
+    };
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Chunk> queue;
+    bool finished = false;
+    bool cancelled = false;
+    std::exception_ptr reader_error;
+
+    IngestStats stats;
+    std::size_t rejected = 0;
+    std::size_t bytes = 0;
+    auto start = clock::now();
+
+    auto reader = std::thread([&] {
+        try {
+            Chunk chunk;
+            std::string carry;
+            auto push = [&] {
+                // Sorted by `char`, as the trie orders children, so that
+                // `load_sorted` never leaves and re-enters a shared prefix.
+                std::string_view chars(chunk.chars);
+                std::stable_sort(chunk.spans.begin(), chunk.spans.end(), [chars](const auto &a, const auto &b) {
+                    return std::ranges::lexicographical_compare(chars.substr(a.first, a.second),
+                                                                chars.substr(b.first, b.second));
+                });
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [&] { return queue.size() < std::max<std::size_t>(options.queue_depth, 1) || cancelled; });
+                if (cancelled) {
+                    return false;
+                }
+                queue.push_back(std::move(chunk));
+                changed.notify_all();
+                lock.unlock();
+                chunk = Chunk();
+                return true;
+            };
+            auto add = [&](std::string_view word) {
+                if (!passes_validation(validator, word)) {
+                    ++rejected;
+                    return true;
+                }
+                chunk.spans.emplace_back(chunk.chars.size(), word.size());
+                chunk.chars.append(word);
+                return chunk.spans.size() < options.chunk_words || push();
+            };
+
+            std::vector<char> block(std::max<std::size_t>(options.block_bytes, 1));
+            bool running = true;
+            while (running && (in.read(block.data(), static_cast<std::streamsize>(block.size())) || in.gcount() > 0)) {
+                std::string_view text(block.data(), static_cast<std::size_t>(in.gcount()));
+                bytes += text.size();
+                std::size_t i = 0;
+                if (!carry.empty()) {
+                    std::size_t end = std::min(text.find_first_of(spaces), text.size());
+                    carry.append(text.substr(0, end));
+                    if (end == text.size()) {
+                        continue;
+                    }
+                    running = add(carry);
+                    carry.clear();
+                    i = end;
+                }
+                while (running && (i = text.find_first_not_of(spaces, i)) != std::string_view::npos) {
+                    std::size_t end = text.find_first_of(spaces, i);
+                    if (end == std::string_view::npos) {
+                        carry.assign(text.substr(i));
+                        break;
+                    }
+                    running = add(text.substr(i, end - i));
+                    i = end;
+                }
+            }
+            if (running && in.bad()) {
+                throw std::runtime_error("error reading word list");
+            }
+            if (running && !carry.empty()) {
+                running = add(carry);
+            }
+            if (running && !chunk.spans.empty()) {
+                push();
+            }
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            reader_error = std::current_exception();
+        }
+        std::lock_guard lock(mutex);
+        finished = true;
+        changed.notify_all();
+    });
+
+    try {
+        std::vector<std::pair<std::string_view, decltype(value_for(std::string_view()))>> entries;
+        while (true) {
+            Chunk chunk;
+            {
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [&] { return !queue.empty() || finished; });
+                if (queue.empty()) {
+                    break;
+                }
+                chunk = std::move(queue.front());
+                queue.pop_front();
+                changed.notify_all();
+            }
+            auto build_start = clock::now();
+            entries.clear();
+            entries.reserve(chunk.spans.size());
+            std::string_view chars(chunk.chars);
+            for (auto [offset, length] : chunk.spans) {
+                std::string_view word = chars.substr(offset, length);
+                entries.emplace_back(word, value_for(word));
+            }
+            // As an rvalue, owned values are moved into the dictionary, not
+            // copied; the vector itself is kept and reused for the next chunk.
+            std::size_t loaded = entries.size();
+            dict.load_sorted(std::move(entries));
+            stats.build_time += clock::now() - build_start;
+            stats.words += loaded;
+            ++stats.chunks;
+        }
+    } catch (...) {
+        {
+            std::lock_guard lock(mutex);
+            cancelled = true;
+            changed.notify_all();
+        }
+        reader.join();
+        throw;
+    }
+    reader.join();
+    if (reader_error) {
+        std::rethrow_exception(reader_error);
+    }
+    stats.rejected = rejected;
+    stats.bytes = bytes;
+    stats.elapsed = clock::now() - start;
+    return stats;
+}
+
+/**
+ * @brief Ingests a word-list file; see the stream overload.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+template<class Dict, class ValueFor, InputValidator<std::string_view> Validator = std::nullptr_t>
+IngestStats ingest_words(const std::string &path, Dict &dict, ValueFor value_for,
+                         const Validator &validator = nullptr, const IngestOptions &options = {}) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open word list: " + path);
+    }
+    return ingest_words(file, dict, std::move(value_for), validator, options);
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file DictionaryInstrumentation.hpp
+ * @brief Optional hot-path counters for Dictionary lookups, inserts and traversals.
+ * @details Instrumentation is compiled in only when `DICTIONARY_ENABLE_INSTRUMENTATION`
+ *          is defined before the first include of Dictionary.hpp; as with any
+ *          configuration macro, define it the same way in every translation
+ *          unit of a program (e.g. on the compiler command line). Otherwise every
+ *          hook is an empty inline function guarded by `if constexpr`, and the
+ *          timers are empty objects, so with instrumentation disabled the hooks
+ *          compile to nothing.
+ *
+ *          When enabled, each thread counts into its own block of counters, so
+ *          the hot path never contends on a shared cache line. `snapshot()` sums
+ *          the live threads' blocks plus the totals of threads that have exited,
+ *          and `to_prometheus()` renders the result in the Prometheus text format.
+ */
+
+#ifdef DICTIONARY_ENABLE_INSTRUMENTATION
+inline constexpr bool dictionary_instrumentation_enabled = true;
+#else
+inline constexpr bool dictionary_instrumentation_enabled = false;
+#endif
+
+/**
+ * @brief The operations whose latency is recorded.
+ */
+enum class DictionaryOp : std::uint8_t {
+    /**
+     * @brief A descent from the root along a key: `word_exist`, `prefix_exist`,
+     *        the lookup step of `auto_complete`, and so on.
+     */
+    Lookup,
+    Insert,
+    Traverse,
+    Count
+};
+
+/**
+ * @brief Summed counters, as returned by `DictionaryInstrumentation::snapshot()`.
+ */
+struct DictionaryCounterSnapshot {
+    static constexpr std::size_t op_count = static_cast<std::size_t>(DictionaryOp::Count);
+
+    /**
+     * @brief Depth buckets hold depths up to 1, 2, 4, ..., 128 characters; the last is unbounded.
+     */
+    static constexpr std::size_t depth_buckets = 9;
+
+    /**
+     * @brief Latency buckets hold durations up to 16ns, 32ns, ..., about 1s; the last is unbounded.
+     */
+    static constexpr std::size_t latency_buckets = 28;
+    static constexpr unsigned latency_first_shift = 4;
+
+    std::uint64_t lookups = 0;
+    std::uint64_t lookup_misses = 0;
+    /**
+     * @brief Nodes entered by lookups, inserts and traversals.
+     */
+    std::uint64_t node_visits = 0;
+    /**
+     * @brief Child-table `find` calls.
+     */
+    std::uint64_t child_probes = 0;
+    std::uint64_t node_allocations = 0;
+    std::uint64_t node_deallocations = 0;
+
+    /**
+     * @brief How deep each lookup got before it ended or missed.
+     */
+    std::array<std::uint64_t, depth_buckets> depth_histogram{};
+    std::uint64_t depth_sum = 0;
+
+    std::array<std::array<std::uint64_t, latency_buckets>, op_count> latency_histogram{};
+    std::array<std::uint64_t, op_count> latency_sum_ns{};
+
+    /**
+     * @brief The upper bound of depth bucket `i`.
+     */
+    static std::uint64_t depth_bound(std::size_t i) {
+        return std::uint64_t{1} << i;
+    }
+
+    /**
+     * @brief The upper bound of latency bucket `i`, in nanoseconds.
+     */
+    static std::uint64_t latency_bound_ns(std::size_t i) {
+        return std::uint64_t{1} << (i + latency_first_shift);
+    }
+
+    /**
+     * @brief The bucket of a value, for bounds `1 << (i + shift)`.
+     */
+    static std::size_t bucket(std::uint64_t value, unsigned shift, std::size_t buckets) {
+        std::size_t i = value <= (std::uint64_t{1} << shift) ? 0 : std::bit_width(value - 1) - shift;
+        return i < buckets ? i : buckets - 1;
+    }
+
+    /**
+     * @brief Formats a sample value without losing small magnitudes.
+     */
+    static std::string format_double(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof buffer, "%.9g", value);
+        return buffer;
+    }
+
+    /**
+     * @brief Renders the counters in the Prometheus text exposition format.
+     * @param prefix Prepended to every metric name, e.g. `dictionary_lookups_total`.
+     */
+    std::string to_prometheus(std::string_view prefix = "dictionary") const {
+        std::string out;
+        std::string name(prefix);
+        auto counter = [&out, &name](const char* metric, const char* help, std::uint64_t value) {
+            out += "# HELP " + name + metric + ' ' + help + '\n';
+            out += "# TYPE " + name + metric + " counter\n";
+            out += name + metric + ' ' + std::to_string(value) + '\n';
+        };
+        counter("_lookups_total", "Descents from the root along a key.", lookups);
+        counter("_lookup_misses_total", "Lookups that left the trie before the key ended.", lookup_misses);
+        counter("_node_visits_total", "Nodes entered by lookups, inserts and traversals.", node_visits);
+        counter("_child_probes_total", "Child table lookups.", child_probes);
+        counter("_node_allocations_total", "Trie nodes allocated.", node_allocations);
+        counter("_node_deallocations_total", "Trie nodes freed individually.", node_deallocations);
+
+        out += "# HELP " + name + "_lookup_depth Characters matched by each lookup.\n";
+        out += "# TYPE " + name + "_lookup_depth histogram\n";
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < depth_buckets; ++i) {
+            cumulative += depth_histogram[i];
+            std::string le = i + 1 < depth_buckets ? std::to_string(depth_bound(i)) : "+Inf";
+            out += name + "_lookup_depth_bucket{le=\"" + le + "\"} " + std::to_string(cumulative) + '\n';
+        }
+        out += name + "_lookup_depth_sum " + std::to_string(depth_sum) + '\n';
+        out += name + "_lookup_depth_count " + std::to_string(cumulative) + '\n';
+
+        static constexpr std::array<const char*, op_count> op_names = {"lookup", "insert", "traverse"};
+        out += "# HELP " + name + "_operation_duration_seconds Latency of dictionary operations.\n";
+        out += "# TYPE " + name + "_operation_duration_seconds histogram\n";
+        for (std::size_t op = 0; op < op_count; ++op) {
+            std::string label = std::string("op=\"") + op_names[op] + '"';
+            cumulative = 0;
+            for (std::size_t i = 0; i < latency_buckets; ++i) {
+                cumulative += latency_histogram[op][i];
+                std::string le = i + 1 < latency_buckets ? format_double(static_cast<double>(latency_bound_ns(i)) * 1e-9) : "+Inf";
+                out += name + "_operation_duration_seconds_bucket{" + label + ",le=\"" + le + "\"} " +
+                       std::to_string(cumulative) + '\n';
+            }
+            out += name + "_operation_duration_seconds_sum{" + label + "} " +
+                   format_double(static_cast<double>(latency_sum_ns[op]) * 1e-9) + '\n';
+            out += name + "_operation_duration_seconds_count{" + label + "} " + std::to_string(cumulative) + '\n';
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief The hooks Dictionary calls on its hot paths, and the snapshot API.
+ */
+class DictionaryInstrumentation {
+private:
+    using Snapshot = DictionaryCounterSnapshot;
+
+    /**
+     * @brief One thread's counters. Only the owning thread writes them, so
+     *        updates are a relaxed load and store rather than a locked add;
+     *        the atomics only make concurrent snapshots well-defined.
+     */
+    struct Counters {
+        std::atomic<std::uint64_t> lookups{0};
+        std::atomic<std::uint64_t> lookup_misses{0};
+        std::atomic<std::uint64_t> node_visits{0};
+        std::atomic<std::uint64_t> child_probes{0};
+        std::atomic<std::uint64_t> node_allocations{0};
+        std::atomic<std::uint64_t> node_deallocations{0};
+        std::array<std::atomic<std::uint64_t>, Snapshot::depth_buckets> depth_histogram{};
+        std::atomic<std::uint64_t> depth_sum{0};
+        std::array<std::array<std::atomic<std::uint64_t>, Snapshot::latency_buckets>, Snapshot::op_count> latency_histogram{};
+        std::array<std::atomic<std::uint64_t>, Snapshot::op_count> latency_sum_ns{};
+
+        void add_to(Snapshot &s) const {
+            auto get = [](const std::atomic<std::uint64_t> &c) { return c.load(std::memory_order_relaxed); };
+            s.lookups += get(lookups);
+            s.lookup_misses += get(lookup_misses);
+            s.node_visits += get(node_visits);
+            s.child_probes += get(child_probes);
+            s.node_allocations += get(node_allocations);
+            s.node_deallocations += get(node_deallocations);
+            for (std::size_t i = 0; i < Snapshot::depth_buckets; ++i) {
+                s.depth_histogram[i] += get(depth_histogram[i]);
+            }
+            s.depth_sum += get(depth_sum);
+            for (std::size_t op = 0; op < Snapshot::op_count; ++op) {
+                for (std::size_t i = 0; i < Snapshot::latency_buckets; ++i) {
+                    s.latency_histogram[op][i] += get(latency_histogram[op][i]);
+                }
+                s.latency_sum_ns[op] += get(latency_sum_ns[op]);
+            }
+        }
+    };
+
+    /**
+     * @brief Every live thread's counters, plus the sum of those that have exited.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<const Counters*> live;
+        Snapshot retired;
+    };
+
+    static Registry &registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    /**
+     * @brief Registers a thread's counters for its lifetime and folds them into
+     *        the retired totals when the thread exits.
+     */
+    struct ThreadCounters {
+        Counters counters;
+
+        ThreadCounters() {
+            Registry &r = registry();
+            std::lock_guard lock(r.mutex);
+            r.live.push_back(&counters);
+        }
+
+        ~ThreadCounters() {
+            Registry &r = registry();
+            std::lock_guard lock(r.mutex);
+            counters.add_to(r.retired);
+            std::erase(r.live, &counters);
+        }
+    };
+
+    static Counters &local() {
+        thread_local ThreadCounters instance;
+        return instance.counters;
+    }
+
+    static void bump(std::atomic<std::uint64_t> &counter, std::uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+public:
+    static constexpr bool enabled = dictionary_instrumentation_enabled;
+
+    static void node_visit(std::uint64_t n = 1) {
+        if constexpr (enabled) {
+            bump(local().node_visits, n);
+        }
+    }
+
+    static void child_probe() {
+        if constexpr (enabled) {
+            bump(local().child_probes);
+        }
+    }
+
+    static void node_allocated() {
+        if constexpr (enabled) {
+            bump(local().node_allocations);
+        }
+    }
+
+    static void node_deallocated() {
+        if constexpr (enabled) {
+            bump(local().node_deallocations);
+        }
+    }
+
+    /**
+     * @brief Records one lookup that matched `depth` characters.
+     * @param hit False if the key left the trie.
+     */
+    static void lookup(std::size_t depth, bool hit) {
+        if constexpr (enabled) {
+            Counters &c = local();
+            bump(c.lookups);
+            if (!hit) {
+                bump(c.lookup_misses);
+            }
+            bump(c.depth_histogram[Snapshot::bucket(depth, 0, Snapshot::depth_buckets)]);
+            bump(c.depth_sum, depth);
+        }
+    }
+
+    /**
+     * @brief Records the duration of one operation, from construction to destruction.
+     * @details An empty object when instrumentation is disabled.
+     */
+    template<DictionaryOp Op, bool = enabled>
+    class Timer {
+    private:
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    public:
+        Timer() = default;
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer&) = delete;
+
+        ~Timer() {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            auto elapsed = static_cast<std::uint64_t>(ns < 0 ? 0 : ns);
+            Counters &c = local();
+            constexpr auto op = static_cast<std::size_t>(Op);
+            bump(c.latency_histogram[op][Snapshot::bucket(elapsed, Snapshot::latency_first_shift,
+                                                          Snapshot::latency_buckets)]);
+            bump(c.latency_sum_ns[op], elapsed);
+        }
+    };
+
+    template<DictionaryOp Op>
+    class Timer<Op, false> {
+    public:
+        // User-provided so an unused timer does not trigger -Wunused-variable.
+        Timer() noexcept {}
+    };
+
+    /**
+     * @brief Sums the counters of every thread, live or exited.
+     * @details Counts from threads still running are read without stopping
+     *          them, so the result is consistent per counter, not across counters.
+     *          All zeros when instrumentation is disabled.
+     */
+    static Snapshot snapshot() {
+        Snapshot s;
+        if constexpr (enabled) {
+            Registry &r = registry();
+            std::lock_guard lock(r.mutex);
+            s = r.retired;
+            for (const Counters* counters : r.live) {
+                counters->add_to(s);
+            }
+        }
+        return s;
+    }
+
+    /**
+     * @brief `snapshot().to_prometheus(prefix)`.
+     */
+    static std::string prometheus(std::string_view prefix = "dictionary") {
+        return snapshot().to_prometheus(prefix);
+    }
+};
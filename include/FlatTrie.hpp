@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @file FlatTrie.hpp
+ * @brief The pointer-free, offset-based trie image written by `Dictionary::save`
+ *        and read in place by `MappedDictionary`.
+ * @details The image is a header followed by three arrays:
+ *          - one `FlatTrieNode` per trie node, in breadth-first order, so the
+ *            children of every node are contiguous and sorted by character;
+ *          - one label byte per node: the character on its incoming edge;
+ *          - one value of type `V` per stored word.
+ *          Offsets are relative to the start of the image, so it can be used
+ *          straight out of a memory mapping with no fix-ups.
+ */
+
+/**
+ * @brief Leading block of a trie image.
+ */
+struct FlatTrieHeader {
+    char magic[8];
+    std::uint32_t version;
+    /**
+     * @brief `sizeof(V)`, checked when the image is opened.
+     */
+    std::uint32_t value_size;
+    std::uint64_t node_count;
+    std::uint64_t value_count;
+    std::uint64_t nodes_offset;
+    std::uint64_t labels_offset;
+    std::uint64_t values_offset;
+    std::uint64_t total_size;
+
+    static constexpr char expected_magic[8] = {'D', 'I', 'C', 'T', 'I', 'M', 'G', '\0'};
+    static constexpr std::uint32_t current_version = 1;
+};
+
+/**
+ * @brief A node of a trie image.
+ */
+struct FlatTrieNode {
+    /**
+     * @brief Index of the first child; children occupy `[first_child, first_child + child_count)`.
+     */
+    std::uint32_t first_child;
+    std::uint32_t child_count;
+    /**
+     * @brief Index into the value array, or `no_value` if no word ends here.
+     */
+    std::uint32_t value;
+
+    static constexpr std::uint32_t no_value = 0xFFFFFFFFu;
+};
+
+/**
+ * @brief Accumulates nodes in breadth-first order and lays them out as an image.
+ * @tparam V The trivially copyable value type stored per word.
+ */
+template<class V>
+class FlatTrieBuilder {
+    static_assert(std::is_trivially_copyable_v<V>, "trie image values must be trivially copyable");
+
+private:
+    std::vector<FlatTrieNode> nodes;
+    std::vector<char> labels;
+    std::vector<V> values;
+
+    static std::size_t align_up(std::size_t n, std::size_t alignment) {
+        return (n + alignment - 1) / alignment * alignment;
+    }
+
+    template<class U>
+    static void put(std::vector<char> &out, std::size_t offset, const U* data, std::size_t count) {
+        if (count) {
+            std::memcpy(out.data() + offset, data, count * sizeof(U));
+        }
+    }
+
+public:
+    /**
+     * @brief Appends a node reached through `label`, returning its index.
+     */
+    std::size_t add_node(char label) {
+        if (nodes.size() >= FlatTrieNode::no_value) {
+            throw std::length_error("trie image supports at most 2^32 - 1 nodes");
+        }
+        nodes.push_back({0, 0, FlatTrieNode::no_value});
+        labels.push_back(label);
+        return nodes.size() - 1;
+    }
+
+    /**
+     * @brief Records that node `index` has `count` children starting at `first`.
+     */
+    void set_children(std::size_t index, std::size_t first, std::size_t count) {
+        nodes[index].first_child = static_cast<std::uint32_t>(first);
+        nodes[index].child_count = static_cast<std::uint32_t>(count);
+    }
+
+    /**
+     * @brief Attaches a value to node `index`.
+     */
+    void set_value(std::size_t index, const V &value) {
+        nodes[index].value = static_cast<std::uint32_t>(values.size());
+        values.push_back(value);
+    }
+
+    /**
+     * @brief Lays the accumulated nodes out as a contiguous image.
+     */
+    std::vector<char> finish() const {
+        FlatTrieHeader header{};
+        std::memcpy(header.magic, FlatTrieHeader::expected_magic, sizeof header.magic);
+        header.version = FlatTrieHeader::current_version;
+        header.value_size = sizeof(V);
+        header.node_count = nodes.size();
+        header.value_count = values.size();
+        header.nodes_offset = align_up(sizeof(FlatTrieHeader), alignof(FlatTrieNode));
+        header.labels_offset = header.nodes_offset + nodes.size() * sizeof(FlatTrieNode);
+        header.values_offset = align_up(header.labels_offset + labels.size(), alignof(V) < 8 ? 8 : alignof(V));
+        header.total_size = header.values_offset + values.size() * sizeof(V);
+
+        std::vector<char> out(header.total_size);
+        put(out, 0, &header, 1);
+        put(out, header.nodes_offset, nodes.data(), nodes.size());
+        put(out, header.labels_offset, labels.data(), labels.size());
+        put(out, header.values_offset, values.data(), values.size());
+        return out;
+    }
+};
+
+/**
+ * @brief Writes an image to a file.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+inline void write_flat_trie(const std::string &path, const std::vector<char> &image) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        throw std::runtime_error("failed to write trie image: " + path);
+    }
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <utility>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "FlatTrie.hpp"
+
+/**
+ * @file MappedDictionary.hpp
+ * @brief A read-only Dictionary view over a trie image produced by `Dictionary::save`.
+ * @details The image is used in place: opening a file maps it and checks its
+ *          node table in one sequential pass, copying nothing, and every
+ *          process that maps the same file shares one copy in the page cache.
+ *          A truncated or corrupt image is rejected when opened rather than
+ *          read out of bounds later.
+ * @note File mapping uses POSIX `mmap`.
+ */
+
+/**
+ * @tparam V The value type stored in the image, as chosen when it was saved.
+ */
+template<class V>
+class MappedDictionary {
+private:
+    const char* base = nullptr;
+    std::size_t size = 0;
+    /**
+     * @brief True if `base` is a mapping this object must unmap.
+     */
+    bool owns_mapping = false;
+
+    const FlatTrieNode* nodes = nullptr;
+    const char* labels = nullptr;
+    const V* values = nullptr;
+
+    void attach(const void* data, std::size_t bytes) {
+        base = static_cast<const char*>(data);
+        size = bytes;
+        FlatTrieHeader header;
+        if (bytes < sizeof header) {
+            throw std::runtime_error("trie image is truncated");
+        }
+        std::memcpy(&header, base, sizeof header);
+        if (std::memcmp(header.magic, FlatTrieHeader::expected_magic, sizeof header.magic) != 0 ||
+            header.version != FlatTrieHeader::current_version) {
+            throw std::runtime_error("not a trie image");
+        }
+        if (header.value_size != sizeof(V)) {
+            throw std::runtime_error("trie image value type mismatch");
+        }
+        if (header.total_size > bytes || header.node_count == 0) {
+            throw std::runtime_error("trie image is truncated");
+        }
+        check_array(header, header.nodes_offset, header.node_count, sizeof(FlatTrieNode), alignof(FlatTrieNode));
+        check_array(header, header.labels_offset, header.node_count, 1, 1);
+        check_array(header, header.values_offset, header.value_count, sizeof(V), alignof(V));
+        nodes = reinterpret_cast<const FlatTrieNode*>(base + header.nodes_offset);
+        labels = base + header.labels_offset;
+        values = reinterpret_cast<const V*>(base + header.values_offset);
+        // Children always come after their parent in breadth-first order, which
+        // also rules out cycles, so traversal terminates on any accepted image.
+        for (std::uint64_t i = 0; i < header.node_count; ++i) {
+            const FlatTrieNode &node = nodes[i];
+            std::uint64_t end = std::uint64_t{node.first_child} + node.child_count;
+            if (node.child_count != 0 && (node.first_child <= i || end > header.node_count)) {
+                throw std::runtime_error("trie image is corrupt: child range out of bounds");
+            }
+            if (node.value != FlatTrieNode::no_value && node.value >= header.value_count) {
+                throw std::runtime_error("trie image is corrupt: value index out of bounds");
+            }
+        }
+    }
+
+    /**
+     * @brief Checks that `count` elements of `element_size` bytes at `offset`
+     *        lie within the image and are suitably aligned.
+     */
+    void check_array(const FlatTrieHeader &header, std::uint64_t offset, std::uint64_t count,
+                     std::size_t element_size, std::size_t alignment) const {
+        if (offset > header.total_size || count > (header.total_size - offset) / element_size) {
+            throw std::runtime_error("trie image is corrupt: array out of bounds");
+        }
+        if ((reinterpret_cast<std::uintptr_t>(base) + offset) % alignment != 0) {
+            throw std::runtime_error("trie image is misaligned");
+        }
+    }
+
+    void unmap() noexcept {
+        if (owns_mapping && base) {
+            ::munmap(const_cast<char*>(base), size);
+        }
+        base = nullptr;
+        owns_mapping = false;
+    }
+
+    /**
+     * @brief Returns the child of `node` reached through `c`, or nullptr.
+     * @details Children are sorted by character, so this is a binary search
+     *          over a contiguous run of label bytes.
+     */
+    const FlatTrieNode* child(const FlatTrieNode* node, char c) const {
+        const char* first = labels + node->first_child;
+        const char* last = first + node->child_count;
+        const char* it = std::lower_bound(first, last, c);
+        if (it == last || *it != c) {
+            return nullptr;
+        }
+        return nodes + (it - labels);
+    }
+
+    const FlatTrieNode* find(std::string_view prefix) const {
+        const FlatTrieNode* cur = nodes;
+        for (char c : prefix) {
+            cur = child(cur, c);
+            if (!cur) {
+                return nullptr;
+            }
+        }
+        return cur;
+    }
+
+    template<typename Func>
+    void traverse_recursive(const FlatTrieNode* node, Func &func) const {
+        if (node->value != FlatTrieNode::no_value) {
+            func(values + node->value);
+        }
+        for (std::uint32_t i = 0; i < node->child_count; ++i) {
+            traverse_recursive(nodes + node->first_child + i, func);
+        }
+    }
+
+public:
+    /**
+     * @brief Maps a trie image file read-only.
+     * @param path The file written by `Dictionary::save`.
+     * @throws std::system_error if the file cannot be opened or mapped.
+     * @throws std::runtime_error if the file is not a valid image for `V`.
+     */
+    explicit MappedDictionary(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "stat " + path);
+        }
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        void* p = bytes ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        int err = errno;
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw std::system_error(bytes ? err : EINVAL, std::generic_category(), "mmap " + path);
+        }
+        owns_mapping = true;
+        try {
+            attach(p, bytes);
+        } catch (...) {
+            size = bytes;
+            unmap();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Views an image already in memory, such as the result of `Dictionary::freeze`.
+     * @note The buffer must outlive this object and be aligned for `V`.
+     */
+    MappedDictionary(const void* data, std::size_t bytes) {
+        attach(data, bytes);
+    }
+
+    MappedDictionary(const MappedDictionary &) = delete;
+    MappedDictionary &operator=(const MappedDictionary&) = delete;
+
+    MappedDictionary(MappedDictionary &&other) noexcept
+        : base(std::exchange(other.base, nullptr)), size(other.size),
+          owns_mapping(std::exchange(other.owns_mapping, false)),
+          nodes(other.nodes), labels(other.labels), values(other.values) {}
+
+    MappedDictionary &operator=(MappedDictionary &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            base = std::exchange(other.base, nullptr);
+            size = other.size;
+            owns_mapping = std::exchange(other.owns_mapping, false);
+            nodes = other.nodes;
+            labels = other.labels;
+            values = other.values;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unmaps the file, if this object mapped one.
+     */
+    ~MappedDictionary() {
+        unmap();
+    }
+
+    /**
+     * @brief Checks if a word exists and returns a pointer to its value.
+     * @return A pointer into the image if the word exists, otherwise nullptr.
+     */
+    const V* word_exist(std::string_view word) const {
+        const FlatTrieNode* node = find(word);
+        return node && node->value != FlatTrieNode::no_value ? values + node->value : nullptr;
+    }
+
+    /**
+     * @brief Checks if any word with the given prefix exists.
+     */
+    bool prefix_exist(std::string_view prefix) const {
+        return find(prefix) != nullptr;
+    }
+
+    /**
+     * @brief Applies a function to every value, in the same order as `Dictionary::traverse`.
+     * @param func Called with a `const V*` for each word.
+     */
+    template<typename Func>
+    void traverse(Func func) const {
+        traverse_recursive(nodes, func);
+    }
+
+    /**
+     * @brief Finds the values of all words with a given prefix.
+     * @param res A vector to which pointers into the image will be added.
+     */
+    void auto_complete(std::string_view prefix, std::vector<const V*> &res) const {
+        const FlatTrieNode* node = find(prefix);
+        if (node) {
+            auto collect = [&res](const V* value) {
+                res.push_back(value);
+            };
+            traverse_recursive(node, collect);
+        }
+    }
+};
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @file NodeAllocator.hpp
+ * @brief Allocation policies used by the tree containers in this collection.
+ * @details A node allocator is a small stateful object owned by the root of a
+ *          container. It hands out raw storage for nodes and their child tables
+ *          through `allocate`/`deallocate`, and may optionally support dropping
+ *          every allocation at once through `release`. A policy that holds
+ *          memory in reserve may report its footprint through `bytes_reserved()`.
+ */
+
+/**
+ * @brief The default policy. Every node is a separate global heap allocation.
+ */
+class HeapNodeAllocator {
+public:
+    /**
+     * @brief True if `release()` frees every outstanding allocation at once.
+     */
+    static constexpr bool bulk_release = false;
+
+    /**
+     * @brief Allocates `bytes` bytes of storage aligned to `alignment`.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    /**
+     * @brief Returns storage previously obtained from `allocate`.
+     */
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+        ::operator delete(p, bytes, std::align_val_t(alignment));
+    }
+
+    /**
+     * @brief No-op. Heap allocations must be returned one at a time.
+     */
+    void release() noexcept {}
+};
+
+/**
+ * @brief A slab arena. Nodes are bump-allocated out of large blocks and
+ *        recycled through per-size free lists.
+ * @details Building a tree with this policy performs one heap call per block
+ *          instead of one per node, keeps nodes packed together in memory, and
+ *          lets the owning container drop the whole tree with a single
+ *          `release()` instead of visiting every node.
+ * @note The arena is not thread-safe; it is meant to be owned by one container.
+ */
+class ArenaNodeAllocator {
+private:
+    /**
+     * @brief Every allocation is rounded up to a multiple of this many bytes.
+     */
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+
+    /**
+     * @brief Allocations larger than this bypass the free lists.
+     */
+    static constexpr std::size_t max_pooled_size = 4096;
+
+    /**
+     * @brief Size of the first block; later blocks double up to `max_block_size`.
+     */
+    static constexpr std::size_t initial_block_size = 64 * 1024;
+    static constexpr std::size_t max_block_size = 16 * 1024 * 1024;
+
+    /**
+     * @brief A freed chunk, threaded into the free list of its size class.
+     */
+    struct FreeChunk {
+        FreeChunk* next;
+    };
+
+    struct BlockDeleter {
+        void operator()(std::byte* p) const noexcept {
+            ::operator delete(p, std::align_val_t(granularity));
+        }
+    };
+
+    using Block = std::unique_ptr<std::byte, BlockDeleter>;
+
+    std::vector<Block> blocks;
+    std::vector<FreeChunk*> free_lists = std::vector<FreeChunk*>(max_pooled_size / granularity + 1, nullptr);
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+    std::size_t next_block_size = initial_block_size;
+    std::size_t reserved = 0;
+
+    static std::size_t round_up(std::size_t bytes) {
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    std::byte* new_block(std::size_t bytes) {
+        // Owned before the vector grows, so a failed reallocation frees the block.
+        Block block(static_cast<std::byte*>(::operator new(bytes, std::align_val_t(granularity))));
+        blocks.push_back(std::move(block));
+        reserved += bytes;
+        return blocks.back().get();
+    }
+
+public:
+    static constexpr bool bulk_release = true;
+
+    ArenaNodeAllocator() = default;
+    ArenaNodeAllocator(const ArenaNodeAllocator&) = delete;
+    ArenaNodeAllocator& operator=(const ArenaNodeAllocator&) = delete;
+
+    /**
+     * @brief Allocates `bytes` bytes of storage.
+     * @note `alignment` must not exceed `alignof(std::max_align_t)`.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        (void)alignment;
+        bytes = round_up(bytes == 0 ? 1 : bytes);
+        if (bytes > max_pooled_size) {
+            // Oversized requests get a block of their own, reclaimed on release().
+            return new_block(bytes);
+        }
+        FreeChunk* &head = free_lists[bytes / granularity];
+        if (head) {
+            FreeChunk* chunk = head;
+            head = chunk->next;
+            return chunk;
+        }
+        if (static_cast<std::size_t>(limit - cursor) < bytes) {
+            cursor = new_block(next_block_size);
+            limit = cursor + next_block_size;
+            if (next_block_size < max_block_size) {
+                next_block_size *= 2;
+            }
+        }
+        void* p = cursor;
+        cursor += bytes;
+        return p;
+    }
+
+    /**
+     * @brief Pushes the chunk onto its size-class free list for reuse.
+     */
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+        (void)alignment;
+        bytes = round_up(bytes == 0 ? 1 : bytes);
+        if (bytes > max_pooled_size) {
+            return; // Kept until release().
+        }
+        FreeChunk* &head = free_lists[bytes / granularity];
+        head = ::new (p) FreeChunk{head};
+    }
+
+    /**
+     * @brief Frees every block at once. All outstanding allocations become invalid.
+     */
+    void release() noexcept {
+        blocks.clear();
+        std::fill(free_lists.begin(), free_lists.end(), nullptr);
+        cursor = limit = nullptr;
+        next_block_size = initial_block_size;
+        reserved = 0;
+    }
+
+    /**
+     * @brief Total bytes of the blocks obtained from the heap, used or not.
+     */
+    std::size_t bytes_reserved() const noexcept {
+        return reserved;
+    }
+};
+
+/**
+ * @brief Adapts a node allocator so standard containers can draw from it.
+ * @tparam U The element type requested by the container.
+ * @tparam NodeAlloc The node allocator policy being adapted.
+ */
+template<class U, class NodeAlloc>
+class NodeAllocatorAdapter {
+private:
+    template<class, class> friend class NodeAllocatorAdapter;
+    NodeAlloc* alloc;
+
+public:
+    using value_type = U;
+
+    explicit NodeAllocatorAdapter(NodeAlloc& alloc) noexcept : alloc(&alloc) {}
+
+    template<class V>
+    NodeAllocatorAdapter(const NodeAllocatorAdapter<V, NodeAlloc>& other) noexcept : alloc(other.alloc) {}
+
+    U* allocate(std::size_t n) {
+        return static_cast<U*>(alloc->allocate(n * sizeof(U), alignof(U)));
+    }
+
+    void deallocate(U* p, std::size_t n) noexcept {
+        alloc->deallocate(p, n * sizeof(U), alignof(U));
+    }
+
+    template<class V>
+    bool operator==(const NodeAllocatorAdapter<V, NodeAlloc>& other) const noexcept {
+        return alloc == other.alloc;
+    }
+
+    template<class V>
+    bool operator!=(const NodeAllocatorAdapter<V, NodeAlloc>& other) const noexcept {
+        return alloc != other.alloc;
+    }
+};
+
+/**
+ * @brief Picks the standard allocator type a container should use for `U`
+ *        when its nodes come from `NodeAlloc`.
+ * @details The plain heap policy maps to the stateless `std::allocator`, so it
+ *          costs nothing per container; every other policy goes through
+ *          `NodeAllocatorAdapter`.
+ */
+template<class U, class NodeAlloc>
+struct std_allocator_for {
+    using type = NodeAllocatorAdapter<U, NodeAlloc>;
+    static type make(NodeAlloc& alloc) noexcept { return type(alloc); }
+};
+
+template<class U>
+struct std_allocator_for<U, HeapNodeAllocator> {
+    using type = std::allocator<U>;
+    static type make(HeapNodeAllocator&) noexcept { return type(); }
+};
@@ -0,0 +1,577 @@
+#pragma once
+
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <climits>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <bit>
+#include "NodeAllocator.hpp"
+
+// Node16 lookups compare all 16 keys at once where the target guarantees a
+// 128-bit byte compare; define DICTIONARY_NO_SIMD to force the scalar loop.
+#if !defined(DICTIONARY_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define DICTIONARY_SIMD_SSE2 1
+#elif !defined(DICTIONARY_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define DICTIONARY_SIMD_NEON 1
+#endif
+
+/**
+ * @file NodeChildren.hpp
+ * @brief Child-table policies used by the tree containers in this collection.
+ * @details A child table maps a character to a child node pointer. Every policy
+ *          exposes the same small interface:
+ *          - `find(c)` returns the child for `c`, or nullptr.
+ *          - `insert(c, child, alloc)` adds a child for a character not yet present.
+ *          - `replace(c, child)` repoints the existing entry for `c`.
+ *          - `erase(c, alloc)` removes the entry for `c`, if any.
+ *          - `size()`/`empty()` report the fan-out.
+ *          - `begin()`/`end()` iterate `(char, Node*)` pairs in `std::less<char>` order.
+ *          - `destroy(alloc)` frees the table's own storage (not the children).
+ *          - `table_bytes()` reports the storage held outside the owning node.
+ *          - `shrink_to_fit(alloc)` moves to the most compact layout for the current fan-out.
+ * @tparam Node The node type the table points to.
+ * @tparam Alloc The node allocator policy the table draws its storage from.
+ */
+
+/**
+ * @brief The position of `c` among the first `n` keys of a 16-byte key block, or `n` if absent.
+ * @details The portable version: one compare per key.
+ */
+inline std::size_t key16_find_scalar(const char* keys, std::size_t n, char c) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keys[i] == c) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Like `key16_find_scalar`, comparing all 16 bytes in one SSE2 or NEON instruction.
+ * @details All 16 bytes of `keys` are read; those past `n` are masked out, so
+ *          their contents do not matter. Falls back to the scalar loop when
+ *          neither instruction set is available.
+ */
+inline std::size_t key16_find(const char* keys, std::size_t n, char c) {
+#if defined(DICTIONARY_SIMD_SSE2)
+    __m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(c), _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << n) - 1);
+    return mask ? static_cast<std::size_t>(std::countr_zero(mask)) : n;
+#elif defined(DICTIONARY_SIMD_NEON)
+    uint8x16_t hits = vceqq_u8(vdupq_n_u8(static_cast<std::uint8_t>(c)),
+                               vld1q_u8(reinterpret_cast<const std::uint8_t*>(keys)));
+    // Narrowing shift leaves 4 bits per key: a 64-bit mask in key order.
+    std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+    if (n < 16) {
+        mask &= (std::uint64_t{1} << (4 * n)) - 1;
+    }
+    return mask ? static_cast<std::size_t>(std::countr_zero(mask)) / 4 : n;
+#else
+    return key16_find_scalar(keys, n, c);
+#endif
+}
+
+/**
+ * @brief Child table backed by `std::map`. One allocation per edge.
+ */
+template<class Node, class Alloc>
+class MapChildren {
+private:
+    using MapAllocator = std_allocator_for<std::pair<const char, Node*>, Alloc>;
+    using Map = std::map<char, Node*, std::less<char>, typename MapAllocator::type>;
+
+    Map map;
+
+public:
+    using const_iterator = typename Map::const_iterator;
+
+    explicit MapChildren(Alloc &alloc) : map(MapAllocator::make(alloc)) {}
+
+    Node* find(char c) const {
+        auto it = map.find(c);
+        return it == map.cend() ? nullptr : it->second;
+    }
+
+    void insert(char c, Node* child, Alloc &) {
+        map.emplace(c, child);
+    }
+
+    void replace(char c, Node* child) {
+        map.find(c)->second = child;
+    }
+
+    void erase(char c, Alloc &) {
+        map.erase(c);
+    }
+
+    std::size_t size() const { return map.size(); }
+    bool empty() const { return map.empty(); }
+    const_iterator begin() const { return map.cbegin(); }
+    const_iterator end() const { return map.cend(); }
+
+    void destroy(Alloc &) {
+        map.clear();
+    }
+
+    /**
+     * @brief Estimated bytes of the map's tree nodes.
+     * @details Each entry is a red-black tree node: colour word, three links
+     *          and the `(char, Node*)` pair. Allocator headers are not included.
+     */
+    std::size_t table_bytes() const {
+        return map.size() * (4 * sizeof(void*) + sizeof(typename Map::value_type));
+    }
+
+    /**
+     * @brief No-op. A map already holds exactly one node per entry.
+     */
+    void shrink_to_fit(Alloc &) {}
+};
+
+/**
+ * @brief Adaptive child table in the style of an Adaptive Radix Tree (ART).
+ * @details The representation grows with the fan-out:
+ *          - up to 4 children: sorted keys and pointers stored inline, no allocation;
+ *          - up to 16: a sorted key array beside a pointer array (Node16),
+ *            searched with one SIMD byte compare (see `key16_find`);
+ *          - up to 48: a 256-entry byte index into 48 pointer slots (Node48);
+ *          - otherwise: a direct 256-slot pointer array (Node256).
+ *          Lookups never chase more than one pointer, and small tables stay
+ *          inside the owning node's cache line.
+ */
+template<class Node, class Alloc>
+class AdaptiveChildren {
+private:
+    enum class Kind : std::uint8_t { Inline, Node16, Node48, Node256 };
+
+    static constexpr std::size_t inline_capacity = 4;
+    static constexpr std::size_t node16_capacity = 16;
+    static constexpr std::size_t node48_capacity = 48;
+
+    struct Node16 {
+        char keys[node16_capacity];
+        Node* children[node16_capacity];
+    };
+
+    struct Node48 {
+        /**
+         * @brief Slot number plus one for each byte value; zero means absent.
+         */
+        std::uint8_t index[256];
+        Node* children[node48_capacity];
+    };
+
+    struct Node256 {
+        Node* children[256];
+    };
+
+    std::uint16_t count = 0;
+    Kind kind = Kind::Inline;
+    char inline_keys[inline_capacity] = {};
+    union {
+        Node* inline_children[inline_capacity] = {};
+        Node16* n16;
+        Node48* n48;
+        Node256* n256;
+    };
+
+    static std::uint8_t byte(char c) {
+        return static_cast<std::uint8_t>(c);
+    }
+
+    template<class Table>
+    static Table* allocate_table(Alloc &alloc) {
+        void* p = alloc.allocate(sizeof(Table), alignof(Table));
+        return ::new (p) Table{};
+    }
+
+    template<class Table>
+    static void free_table(Table* table, Alloc &alloc) {
+        alloc.deallocate(table, sizeof(Table), alignof(Table));
+    }
+
+    /**
+     * @brief Inserts into a sorted key/pointer array pair with room for one more.
+     */
+    static void sorted_insert(char* keys, Node** children, std::size_t n, char c, Node* child) {
+        std::size_t pos = n;
+        while (pos > 0 && c < keys[pos - 1]) {
+            keys[pos] = keys[pos - 1];
+            children[pos] = children[pos - 1];
+            --pos;
+        }
+        keys[pos] = c;
+        children[pos] = child;
+    }
+
+    static Node* sorted_find(const char* keys, Node* const* children, std::size_t n, char c) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (keys[i] == c) {
+                return children[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void grow(Alloc &alloc) {
+        switch (kind) {
+        case Kind::Inline: {
+            Node16* table = allocate_table<Node16>(alloc);
+            std::memcpy(table->keys, inline_keys, count);
+            std::memcpy(table->children, inline_children, count * sizeof(Node*));
+            n16 = table;
+            kind = Kind::Node16;
+            break;
+        }
+        case Kind::Node16: {
+            Node48* table = allocate_table<Node48>(alloc);
+            for (std::size_t i = 0; i < count; ++i) {
+                table->index[byte(n16->keys[i])] = static_cast<std::uint8_t>(i + 1);
+                table->children[i] = n16->children[i];
+            }
+            free_table(n16, alloc);
+            n48 = table;
+            kind = Kind::Node48;
+            break;
+        }
+        case Kind::Node48: {
+            Node256* table = allocate_table<Node256>(alloc);
+            for (std::size_t b = 0; b < 256; ++b) {
+                if (n48->index[b]) {
+                    table->children[b] = n48->children[n48->index[b] - 1];
+                }
+            }
+            free_table(n48, alloc);
+            n256 = table;
+            kind = Kind::Node256;
+            break;
+        }
+        case Kind::Node256:
+            break;
+        }
+    }
+
+    /**
+     * @brief Switches to the `target` kind. `count` must fit in `target`.
+     * @details Used both to grow one step and to shrink back after erasures.
+     *          If allocating the new table throws, the table is left unchanged.
+     */
+    void convert(Kind target, Alloc &alloc) {
+        if (target == kind) {
+            return;
+        }
+        if (target > kind) {
+            while (kind < target) {
+                grow(alloc);
+            }
+            return;
+        }
+        // Allocate the smaller table before anything is freed, gather the
+        // children in order, then rebuild into the smaller kind.
+        Node16* table16 = target == Kind::Node16 ? allocate_table<Node16>(alloc) : nullptr;
+        Node48* table48 = target == Kind::Node48 ? allocate_table<Node48>(alloc) : nullptr;
+        char keys[256];
+        Node* children[256];
+        std::size_t n = 0;
+        for (auto [c, child] : *this) {
+            keys[n] = c;
+            children[n] = child;
+            ++n;
+        }
+        destroy(alloc);
+        switch (target) {
+        case Kind::Inline: break;
+        case Kind::Node16: n16 = table16; break;
+        case Kind::Node48: n48 = table48; break;
+        case Kind::Node256: break;
+        }
+        kind = target;
+        for (std::size_t i = 0; i < n; ++i) {
+            insert_unchecked(keys[i], children[i]);
+        }
+    }
+
+    /**
+     * @brief The smallest kind that can hold `n` children.
+     */
+    static Kind fitting_kind(std::size_t n) {
+        if (n <= inline_capacity) return Kind::Inline;
+        if (n <= node16_capacity) return Kind::Node16;
+        if (n <= node48_capacity) return Kind::Node48;
+        return Kind::Node256;
+    }
+
+    /**
+     * @brief Adds a child assuming the current kind has room.
+     */
+    void insert_unchecked(char c, Node* child) {
+        switch (kind) {
+        case Kind::Inline:
+            sorted_insert(inline_keys, inline_children, count, c, child);
+            break;
+        case Kind::Node16:
+            sorted_insert(n16->keys, n16->children, count, c, child);
+            break;
+        case Kind::Node48: {
+            std::size_t slot = 0;
+            while (n48->children[slot]) {
+                ++slot;
+            }
+            n48->children[slot] = child;
+            n48->index[byte(c)] = static_cast<std::uint8_t>(slot + 1);
+            break;
+        }
+        case Kind::Node256:
+            n256->children[byte(c)] = child;
+            break;
+        }
+        ++count;
+    }
+
+    /**
+     * @brief Locates the pointer slot for `c`, or nullptr if absent.
+     */
+    Node** find_slot(char c) {
+        switch (kind) {
+        case Kind::Inline:
+            for (std::size_t i = 0; i < count; ++i) {
+                if (inline_keys[i] == c) return &inline_children[i];
+            }
+            return nullptr;
+        case Kind::Node16: {
+            std::size_t i = key16_find(n16->keys, count, c);
+            return i < count ? &n16->children[i] : nullptr;
+        }
+        case Kind::Node48: {
+            std::uint8_t slot = n48->index[byte(c)];
+            return slot ? &n48->children[slot - 1] : nullptr;
+        }
+        case Kind::Node256:
+            return n256->children[byte(c)] ? &n256->children[byte(c)] : nullptr;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Removes `pos` from a sorted key/pointer array pair of length `n`.
+     */
+    static void sorted_erase(char* keys, Node** children, std::size_t n, std::size_t pos) {
+        for (std::size_t i = pos + 1; i < n; ++i) {
+            keys[i - 1] = keys[i];
+            children[i - 1] = children[i];
+        }
+    }
+
+    bool full() const {
+        switch (kind) {
+        case Kind::Inline: return count == inline_capacity;
+        case Kind::Node16: return count == node16_capacity;
+        case Kind::Node48: return count == node48_capacity;
+        case Kind::Node256: return false;
+        }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Forward iterator over `(char, Node*)` pairs in `std::less<char>` order.
+     */
+    class const_iterator {
+    private:
+        friend class AdaptiveChildren;
+        const AdaptiveChildren* owner = nullptr;
+        /**
+         * @brief Array position for sorted kinds, character value for indexed kinds.
+         */
+        int pos = 0;
+
+        const_iterator(const AdaptiveChildren* owner, int pos) : owner(owner), pos(pos) {
+            skip_empty();
+        }
+
+        bool indexed() const {
+            return owner->kind == Kind::Node48 || owner->kind == Kind::Node256;
+        }
+
+        void skip_empty() {
+            if (indexed()) {
+                while (pos <= CHAR_MAX && !owner->indexed_child(static_cast<char>(pos))) {
+                    ++pos;
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<char, Node*>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() = default;
+
+        value_type operator*() const {
+            if (indexed()) {
+                char c = static_cast<char>(pos);
+                return {c, owner->indexed_child(c)};
+            }
+            if (owner->kind == Kind::Inline) {
+                return {owner->inline_keys[pos], owner->inline_children[pos]};
+            }
+            return {owner->n16->keys[pos], owner->n16->children[pos]};
+        }
+
+        const_iterator& operator++() {
+            ++pos;
+            skip_empty();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator &other) const { return pos == other.pos; }
+        bool operator!=(const const_iterator &other) const { return pos != other.pos; }
+    };
+
+    explicit AdaptiveChildren(Alloc &) {}
+    AdaptiveChildren(const AdaptiveChildren&) = delete;
+    AdaptiveChildren& operator=(const AdaptiveChildren&) = delete;
+
+    Node* find(char c) const {
+        switch (kind) {
+        case Kind::Inline: return sorted_find(inline_keys, inline_children, count, c);
+        case Kind::Node16: {
+            std::size_t i = key16_find(n16->keys, count, c);
+            return i < count ? n16->children[i] : nullptr;
+        }
+        case Kind::Node48:
+        case Kind::Node256: return indexed_child(c);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Adds a child for `c`, growing the representation if it is full.
+     * @pre `c` is not present and `child` is not nullptr.
+     */
+    void insert(char c, Node* child, Alloc &alloc) {
+        if (full()) {
+            grow(alloc);
+        }
+        insert_unchecked(c, child);
+    }
+
+    /**
+     * @pre `c` is present and `child` is not nullptr.
+     */
+    void replace(char c, Node* child) {
+        *find_slot(c) = child;
+    }
+
+    /**
+     * @brief Removes the child for `c`, shrinking the representation once the
+     *        fan-out drops well below the current kind's capacity.
+     */
+    void erase(char c, Alloc &alloc) {
+        Node** slot = find_slot(c);
+        if (!slot) {
+            return;
+        }
+        switch (kind) {
+        case Kind::Inline:
+            sorted_erase(inline_keys, inline_children, count, static_cast<std::size_t>(slot - inline_children));
+            inline_children[count - 1] = nullptr;
+            break;
+        case Kind::Node16:
+            sorted_erase(n16->keys, n16->children, count, static_cast<std::size_t>(slot - n16->children));
+            break;
+        case Kind::Node48:
+            *slot = nullptr;
+            n48->index[byte(c)] = 0;
+            break;
+        case Kind::Node256:
+            *slot = nullptr;
+            break;
+        }
+        --count;
+        // Shrink with some hysteresis so alternating insert/erase does not thrash.
+        // Shrinking only saves memory, so if the smaller table cannot be
+        // allocated the children simply stay where they are.
+        if ((kind == Kind::Node16 && count < inline_capacity) ||
+            (kind == Kind::Node48 && count < node16_capacity - 4) ||
+            (kind == Kind::Node256 && count < node48_capacity - 8)) {
+            try {
+                convert(fitting_kind(count), alloc);
+            } catch (...) {
+            }
+        }
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const_iterator begin() const {
+        return const_iterator(this, kind == Kind::Node48 || kind == Kind::Node256 ? CHAR_MIN : 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, kind == Kind::Node48 || kind == Kind::Node256 ? CHAR_MAX + 1 : count);
+    }
+
+    /**
+     * @brief Frees any out-of-line table and returns to the empty inline state.
+     */
+    void destroy(Alloc &alloc) {
+        switch (kind) {
+        case Kind::Inline: break;
+        case Kind::Node16: free_table(n16, alloc); break;
+        case Kind::Node48: free_table(n48, alloc); break;
+        case Kind::Node256: free_table(n256, alloc); break;
+        }
+        kind = Kind::Inline;
+        count = 0;
+        for (Node* &child : inline_children) {
+            child = nullptr;
+        }
+    }
+
+    /**
+     * @brief Bytes of the out-of-line table, zero while the children fit inline.
+     */
+    std::size_t table_bytes() const {
+        switch (kind) {
+        case Kind::Inline: return 0;
+        case Kind::Node16: return sizeof(Node16);
+        case Kind::Node48: return sizeof(Node48);
+        case Kind::Node256: return sizeof(Node256);
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Drops to the smallest kind that holds the current children.
+     * @details `erase` only shrinks past a hysteresis margin; this closes the gap.
+     */
+    void shrink_to_fit(Alloc &alloc) {
+        convert(fitting_kind(count), alloc);
+    }
+
+private:
+    Node* indexed_child(char c) const {
+        if (kind == Kind::Node48) {
+            std::uint8_t slot = n48->index[byte(c)];
+            return slot ? n48->children[slot - 1] : nullptr;
+        }
+        return n256->children[byte(c)];
+    }
+};
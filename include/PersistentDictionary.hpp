@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file PersistentDictionary.hpp
+ * @brief A trie with O(1) snapshots, built from persistent, path-copying nodes.
+ * @details Copying a `PersistentDictionary` (or calling `snapshot()`) shares the
+ *          whole tree and costs one reference-count increment. Nodes reachable
+ *          from more than one copy are never modified: an update copies only
+ *          the nodes on its root-to-word path that are still shared, and edits
+ *          nodes it already owns in place. So a writer can keep inserting while
+ *          a background exporter walks a snapshot taken a moment earlier.
+ *
+ * @code
+ * PersistentDictionary<Route> routes;
+ * routes.insert(&home, "/home");
+ * auto frozen = routes.snapshot();      // O(1)
+ * std::thread exporter([frozen] { frozen.traverse_with_keys(write_row); });
+ * routes.insert(&about, "/about");      // copies only the changed path
+ * @endcode
+ *
+ * @note One `PersistentDictionary` object must not be used from several
+ *       threads at once, but different copies may be, including while one is
+ *       being written: copies share nothing mutable.
+ */
+
+/**
+ * @tparam T The type of the objects associated with words. As in `Dictionary`,
+ *         the dictionary stores `T*` and does not own the objects; snapshots
+ *         keep the pointers they had when taken.
+ */
+template<class T>
+class PersistentDictionary {
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<Node>;
+
+    struct Node {
+        /**
+         * @brief Pointer to the object associated with a complete word, or nullptr.
+         */
+        T* object = nullptr;
+
+        /**
+         * @brief The number of words in this subtree, including the one ending here.
+         */
+        std::size_t count = 0;
+
+        /**
+         * @brief Children sorted by `std::less<char>`, matching `Dictionary`'s traversal order.
+         */
+        std::vector<std::pair<char, NodePtr>> childs;
+
+        const Node* find(char c) const {
+            auto it = std::lower_bound(childs.begin(), childs.end(), c,
+                                       [](const auto &entry, char key) { return entry.first < key; });
+            return it != childs.end() && it->first == c ? it->second.get() : nullptr;
+        }
+
+        /**
+         * @brief Removes the child for `c`, which must exist, and returns it.
+         */
+        NodePtr unlink(char c) {
+            auto it = std::lower_bound(childs.begin(), childs.end(), c,
+                                       [](const auto &entry, char key) { return entry.first < key; });
+            NodePtr child = std::move(it->second);
+            childs.erase(it);
+            return child;
+        }
+
+        /**
+         * @brief The slot for `c`, inserting an empty one if absent.
+         */
+        NodePtr &slot(char c) {
+            auto it = std::lower_bound(childs.begin(), childs.end(), c,
+                                       [](const auto &entry, char key) { return entry.first < key; });
+            if (it == childs.end() || it->first != c) {
+                it = childs.emplace(it, c, nullptr);
+            }
+            return it->second;
+        }
+    };
+
+    /**
+     * @brief The root, or nullptr while the dictionary is empty.
+     */
+    NodePtr root;
+
+    /**
+     * @brief Makes the node in `slot` exclusive to this dictionary, copying it if it is shared.
+     * @details A node only this dictionary references cannot be reached from
+     *          any snapshot, because a snapshot would also hold every ancestor.
+     *          The fence pairs with the release in other threads' last
+     *          decrement, so their reads of the node happen before our writes.
+     */
+    static Node* own(NodePtr &slot) {
+        if (!slot) {
+            slot = std::make_shared<Node>();
+        } else if (slot.use_count() != 1) {
+            slot = std::make_shared<Node>(*slot);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return slot.get();
+    }
+
+    const Node* find(std::string_view prefix) const {
+        const Node* cur = root.get();
+        for (char c : prefix) {
+            if (!cur) {
+                return nullptr;
+            }
+            cur = cur->find(c);
+        }
+        return cur;
+    }
+
+    template<typename Func>
+    static void traverse_recursive(const Node* node, Func &func) {
+        if (node->object) {
+            func(node->object);
+        }
+        for (auto const& [c, child] : node->childs) {
+            traverse_recursive(child.get(), func);
+        }
+    }
+
+    template<typename Func>
+    static void traverse_keys_recursive(const Node* node, std::string &key, Func &func) {
+        if (node->object) {
+            func(std::string_view(key), node->object);
+        }
+        for (auto const& [c, child] : node->childs) {
+            key.push_back(c);
+            traverse_keys_recursive(child.get(), key, func);
+            key.pop_back();
+        }
+    }
+
+    /**
+     * @brief Drops a subtree iteratively, so tearing down a deep unshared trie cannot overflow the stack.
+     */
+    static void release(NodePtr node) noexcept {
+        std::vector<NodePtr> pending;
+        pending.push_back(std::move(node));
+        // Children are moved out before a node dies, so each destructor is shallow.
+        while (!pending.empty()) {
+            NodePtr cur = std::move(pending.back());
+            pending.pop_back();
+            if (cur && cur.use_count() == 1) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                for (auto &[c, child] : cur->childs) {
+                    pending.push_back(std::move(child));
+                }
+            }
+        }
+    }
+
+public:
+    PersistentDictionary() = default;
+
+    /**
+     * @brief Builds a persistent copy of another dictionary.
+     * @tparam Dict Any dictionary providing `traverse_with_keys`, e.g. `Dictionary<T>`.
+     */
+    template<class Dict>
+        requires (!std::is_same_v<std::remove_cvref_t<Dict>, PersistentDictionary>)
+    explicit PersistentDictionary(const Dict &dict) {
+        dict.traverse_with_keys([this](std::string_view key, T* object) { insert(object, key); });
+    }
+
+    /**
+     * @brief Copies are snapshots: O(1), sharing every node until either side writes.
+     */
+    PersistentDictionary(const PersistentDictionary &) = default;
+    PersistentDictionary(PersistentDictionary &&) noexcept = default;
+
+    /**
+     * @brief Shares `other`'s tree; the tree replaced is dropped with `release`, as in the destructor.
+     */
+    PersistentDictionary &operator=(const PersistentDictionary &other) {
+        NodePtr shared = other.root;
+        release(std::exchange(root, std::move(shared)));
+        return *this;
+    }
+
+    PersistentDictionary &operator=(PersistentDictionary &&other) noexcept {
+        if (this != &other) {
+            release(std::exchange(root, std::move(other.root)));
+        }
+        return *this;
+    }
+
+    ~PersistentDictionary() {
+        release(std::move(root));
+    }
+
+    /**
+     * @brief Returns an O(1) snapshot of the current contents.
+     * @details Later writes to either dictionary are not seen by the other.
+     */
+    PersistentDictionary snapshot() const {
+        return *this;
+    }
+
+    /**
+     * @brief Inserts a word and associates an object with it.
+     * @details Copies the shared nodes on the word's path; nodes owned by
+     *          this dictionary alone are updated in place.
+     * @param object The object to associate; not owned by the dictionary.
+     * @param word The word to insert.
+     * @note If the word already exists, its associated object pointer is overwritten.
+     *       A nullptr object stores no word, so it removes `word` as `erase` does.
+     */
+    void insert(T *object, std::string_view word) {
+        if (!object) {
+            erase(word);
+            return;
+        }
+        bool added = !word_exist(word);
+        Node* cur = own(root);
+        cur->count += added;
+        for (char c : word) {
+            cur = own(cur->slot(c));
+            cur->count += added;
+        }
+        cur->object = object;
+    }
+
+    /**
+     * @brief Removes a word, dropping the nodes that no longer lead to any word.
+     * @details Stops copying at the first node whose subtree held only this
+     *          word: that subtree is unlinked whole instead.
+     * @return True if the word was present.
+     */
+    bool erase(std::string_view word) {
+        if (!word_exist(word)) {
+            return false;
+        }
+        if (root->count == 1) {
+            clear();
+            return true;
+        }
+        Node* cur = own(root);
+        --cur->count;
+        for (char c : word) {
+            if (cur->slot(c)->count == 1) {
+                release(cur->unlink(c));
+                return true;
+            }
+            cur = own(cur->slot(c));
+            --cur->count;
+        }
+        cur->object = nullptr;
+        return true;
+    }
+
+    /**
+     * @brief Checks if a word exists and returns its associated object.
+     * @return The associated object, or nullptr if the word is absent.
+     */
+    T* word_exist(std::string_view word) const {
+        const Node* node = find(word);
+        return node ? node->object : nullptr;
+    }
+
+    /**
+     * @brief Checks if any word starts with `prefix`.
+     */
+    bool prefix_exist(std::string_view prefix) const {
+        return find(prefix) != nullptr;
+    }
+
+    /**
+     * @brief The number of words starting with `prefix`.
+     */
+    std::size_t count_prefix(std::string_view prefix) const {
+        const Node* node = find(prefix);
+        return node ? node->count : 0;
+    }
+
+    /**
+     * @brief Finds the objects of all words with a given prefix, in traversal order.
+     * @param res A vector to which the matching objects will be added.
+     */
+    void auto_complete(std::string_view prefix, std::vector<T*> &res) const {
+        if (const Node* node = find(prefix)) {
+            auto collect = [&res](T* object) { res.push_back(object); };
+            traverse_recursive(node, collect);
+        }
+    }
+
+    /**
+     * @brief The number of words stored.
+     */
+    std::size_t size() const {
+        return root ? root->count : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Applies a function to every object, in lexicographic order of the words.
+     * @param func Called with a `T*` for each word.
+     */
+    template<typename Func>
+    void traverse(Func func) const {
+        if (root) {
+            traverse_recursive(root.get(), func);
+        }
+    }
+
+    /**
+     * @brief Like `traverse`, also passing each word.
+     * @param func Called with `(std::string_view word, T* object)`.
+     */
+    template<typename Func>
+    void traverse_with_keys(Func func) const {
+        if (root) {
+            std::string key;
+            traverse_keys_recursive(root.get(), key, func);
+        }
+    }
+
+    /**
+     * @brief Removes every word. Snapshots keep their contents.
+     */
+    void clear() {
+        release(std::move(root));
+        root = nullptr;
+    }
+};
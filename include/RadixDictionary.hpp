@@ -0,0 +1,376 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <bit>
+#include <new>
+#include "NodeAllocator.hpp"
+#include "NodeChildren.hpp"
+
+/**
+ * @file RadixDictionary.hpp
+ * @brief Contains a path-compressed (radix / Patricia) variant of Dictionary.
+ * @details Chains of nodes with a single child and no object collapse into one
+ *          node whose incoming edge carries a whole string label. Memory grows
+ *          with the number of keys instead of their total length, and lookups
+ *          compare label spans at once instead of descending byte by byte.
+ */
+
+/**
+ * @brief Returns the length of the common prefix of `a` and `b`, both at least `n` bytes long.
+ * @details On little-endian targets, compares a machine word at a time and
+ *          locates the first differing byte from the XOR of the two words.
+ */
+inline std::size_t common_prefix_length(const char* a, const char* b, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t)) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a + i, sizeof x);
+            std::memcpy(&y, b + i, sizeof y);
+            if (std::uint64_t diff = x ^ y) {
+                return i + static_cast<std::size_t>(std::countr_zero(diff)) / CHAR_BIT;
+            }
+        }
+    }
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @tparam T The type of the objects associated with words.
+ * @tparam Allocator The node allocation policy (see NodeAllocator.hpp).
+ * @tparam Children The child-table policy (see NodeChildren.hpp). Children are
+ *         keyed by the first character of their label.
+ */
+template<class T, class Allocator = HeapNodeAllocator,
+         template<class, class> class Children = MapChildren>
+class RadixDictionary {
+private:
+    /**
+     * @brief A single radix node: the label on its incoming edge, an optional
+     *        object, and its children.
+     */
+    struct Node {
+        /**
+         * @brief Pointer to the object associated with the word ending here, or nullptr.
+         * @warning Not owned by the dictionary.
+         */
+        T* object = nullptr;
+
+        /**
+         * @brief Characters on the edge from the parent. Empty only for the root.
+         */
+        char* label = nullptr;
+        std::size_t label_size = 0;
+
+        Children<Node, Allocator> childs;
+
+        explicit Node(Allocator &alloc) : childs(alloc) {}
+    };
+
+    /**
+     * @brief The result of descending along a key.
+     */
+    struct Position {
+        /**
+         * @brief The deepest node reached, or nullptr if the key left the tree.
+         */
+        Node* node = nullptr;
+        /**
+         * @brief True if the key ended exactly at `node` rather than inside its label.
+         */
+        bool exact = false;
+    };
+
+    Allocator alloc;
+    Node* root;
+
+    char* allocate_label(const char* chars, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        char* label = static_cast<char*>(alloc.allocate(n, alignof(char)));
+        std::memcpy(label, chars, n);
+        return label;
+    }
+
+    void free_label(Node* node) noexcept {
+        if (node->label) {
+            alloc.deallocate(node->label, node->label_size, alignof(char));
+        }
+    }
+
+    /**
+     * @brief Replaces a node's label with a copy of `chars[0, n)`.
+     */
+    void set_label(Node* node, const char* chars, std::size_t n) {
+        char* label = allocate_label(chars, n);
+        free_label(node);
+        node->label = label;
+        node->label_size = n;
+    }
+
+    Node* create_node(const char* label, std::size_t n) {
+        void* p = alloc.allocate(sizeof(Node), alignof(Node));
+        Node* node = ::new (p) Node(alloc);
+        node->label = allocate_label(label, n);
+        node->label_size = n;
+        return node;
+    }
+
+    /**
+     * @brief Frees a single node, leaving its children alone.
+     */
+    void free_node(Node* node) noexcept {
+        free_label(node);
+        node->childs.destroy(alloc);
+        node->~Node();
+        alloc.deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    /**
+     * @brief Recursively destroys a node and its whole subtree.
+     */
+    void destroy_node(Node* node) noexcept {
+        for (auto const& [c, child] : node->childs) {
+            destroy_node(child);
+        }
+        free_node(node);
+    }
+
+    /**
+     * @brief Descends along `key`, comparing whole labels at each step.
+     */
+    Position find(std::string_view key) const {
+        Node* cur = root;
+        std::size_t i = 0;
+        while (i < key.size()) {
+            Node* child = cur->childs.find(key[i]);
+            if (!child) {
+                return {};
+            }
+            std::size_t rest = key.size() - i;
+            if (rest < child->label_size) {
+                // The key ends inside this edge.
+                if (std::memcmp(child->label, key.data() + i, rest) != 0) {
+                    return {};
+                }
+                return {child, false};
+            }
+            if (std::memcmp(child->label, key.data() + i, child->label_size) != 0) {
+                return {};
+            }
+            i += child->label_size;
+            cur = child;
+        }
+        return {cur, true};
+    }
+
+    /**
+     * @brief Collapses `node` into its only child. `node` must hold no object.
+     * @param parent The parent of `node`.
+     */
+    void merge_with_child(Node* parent, Node* node) {
+        Node* child = (*node->childs.begin()).second;
+        std::string label(node->label, node->label_size);
+        label.append(child->label, child->label_size);
+        set_label(child, label.data(), label.size());
+        parent->childs.replace(label[0], child);
+        free_node(node);
+    }
+
+    template<typename Func>
+    static void traverse_recursive(const Node* node, Func &func) {
+        if (node->object) {
+            func(node->object);
+        }
+        for (auto const& [key, child] : node->childs) {
+            traverse_recursive(child, func);
+        }
+    }
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    RadixDictionary() : root(create_node(nullptr, 0)) {}
+
+    /**
+     * @brief Copy constructor is deleted to prevent shallow copies and double frees.
+     */
+    RadixDictionary(const RadixDictionary &) = delete;
+
+    /**
+     * @brief Copy assignment operator is deleted to prevent shallow copies.
+     */
+    RadixDictionary &operator=(const RadixDictionary&) = delete;
+
+    /**
+     * @brief Destructor. Frees all nodes.
+     * @note This does NOT deallocate the `T* object` pointers.
+     */
+    ~RadixDictionary() {
+        if constexpr (Allocator::bulk_release) {
+            alloc.release();
+        } else {
+            destroy_node(root);
+        }
+    }
+
+    /**
+     * @brief Inserts a word and associates an object with it, splitting an edge if needed.
+     * @param object A pointer to the object to associate with the word. Not owned.
+     * @param word The word to insert.
+     * @note If the word already exists, its associated object pointer will be overwritten.
+     */
+    void insert(T *object, std::string_view word) {
+        Node* cur = root;
+        std::size_t i = 0;
+        while (i < word.size()) {
+            Node* child = cur->childs.find(word[i]);
+            if (!child) {
+                Node* leaf = create_node(word.data() + i, word.size() - i);
+                leaf->object = object;
+                cur->childs.insert(word[i], leaf, alloc);
+                return;
+            }
+            std::size_t n = std::min(child->label_size, word.size() - i);
+            std::size_t common = common_prefix_length(child->label, word.data() + i, n);
+            if (common == child->label_size) {
+                cur = child;
+                i += common;
+                continue;
+            }
+            // Split the edge: a new node takes the shared part of the label.
+            Node* mid = create_node(child->label, common);
+            set_label(child, child->label + common, child->label_size - common);
+            mid->childs.insert(child->label[0], child, alloc);
+            cur->childs.replace(word[i], mid);
+            i += common;
+            if (i == word.size()) {
+                mid->object = object;
+            } else {
+                Node* leaf = create_node(word.data() + i, word.size() - i);
+                leaf->object = object;
+                mid->childs.insert(word[i], leaf, alloc);
+            }
+            return;
+        }
+        cur->object = object;
+    }
+
+    /**
+     * @brief Removes a word, merging edges that no longer branch.
+     * @param word The word to remove.
+     * @return True if the word was present.
+     * @note This does NOT deallocate the associated object.
+     */
+    bool erase(std::string_view word) {
+        Node* parent = nullptr;
+        Node* grandparent = nullptr;
+        Node* cur = root;
+        std::size_t i = 0;
+        while (i < word.size()) {
+            Node* child = cur->childs.find(word[i]);
+            if (!child || word.size() - i < child->label_size ||
+                std::memcmp(child->label, word.data() + i, child->label_size) != 0) {
+                return false;
+            }
+            i += child->label_size;
+            grandparent = parent;
+            parent = cur;
+            cur = child;
+        }
+        if (!cur->object) {
+            return false;
+        }
+        cur->object = nullptr;
+        if (cur == root) {
+            return true;
+        }
+        if (cur->childs.empty()) {
+            parent->childs.erase(cur->label[0], alloc);
+            free_node(cur);
+            if (parent != root && !parent->object && parent->childs.size() == 1) {
+                merge_with_child(grandparent, parent);
+            }
+        } else if (cur->childs.size() == 1) {
+            merge_with_child(parent, cur);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if a word exists and returns a pointer to its associated object.
+     * @param word The word to search for.
+     * @return A pointer to the associated object if the word exists, otherwise nullptr.
+     */
+    T* word_exist(std::string_view word) {
+        return const_cast<T*>(static_cast<const RadixDictionary*>(this)->word_exist(word));
+    }
+
+    /**
+     * @brief Checks if a word exists (const version).
+     * @param word The word to search for.
+     * @return A const pointer to the associated object if the word exists, otherwise nullptr.
+     */
+    const T* word_exist(std::string_view word) const {
+        Position pos = find(word);
+        return pos.exact ? pos.node->object : nullptr;
+    }
+
+    /**
+     * @brief Checks if any word with the given prefix exists.
+     * @param prefix The prefix to check.
+     * @return True if the prefix exists, false otherwise.
+     */
+    bool prefix_exist(std::string_view prefix) const {
+        return find(prefix).node != nullptr;
+    }
+
+    /**
+     * @brief Traverses the entire dictionary and applies a function to each object.
+     * @tparam Func The type of the callable function (e.g., a lambda).
+     * @param func The function to apply. It will be called with a `T*` for each object.
+     */
+    template<typename Func>
+    void traverse(Func func) const {
+        traverse_recursive(root, func);
+    }
+
+    /**
+     * @brief Finds all words with a given prefix (auto-completion).
+     * @param prefix The prefix to search for.
+     * @param res A vector to which the pointers of matching objects will be added.
+     */
+    void auto_complete(std::string_view prefix, std::vector<T*> &res) const {
+        Position pos = find(prefix);
+        if (pos.node) {
+            auto collect = [&res](T* obj) {
+                res.push_back(obj);
+            };
+            traverse_recursive(pos.node, collect);
+        }
+    }
+
+    /**
+     * @brief Clears the dictionary, deallocating all nodes.
+     * @note This does NOT deallocate the `T* object` pointers themselves.
+     */
+    void clear() {
+        if constexpr (Allocator::bulk_release) {
+            alloc.release();
+        } else {
+            destroy_node(root);
+        }
+        root = create_node(nullptr, 0);
+    }
+};
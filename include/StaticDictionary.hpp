@@ -0,0 +1,308 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @file StaticDictionary.hpp
+ * @brief A read-only trie built entirely at compile time from a fixed key set.
+ * @details Meant for keyword tables known when the program is written, such as
+ *          command names, HTTP headers or SQL keywords. The trie is a
+ *          `constexpr` object: it is laid out by the compiler into read-only
+ *          data, so there is no startup cost and no heap allocation, and a
+ *          lookup of a constant key folds to its result at compile time.
+ *
+ *          Nodes are stored in depth-first order, with the entries sorted in the
+ *          same order, so every subtree covers a contiguous run of nodes and of
+ *          entries. Prefix completion therefore returns a span instead of
+ *          walking the subtree.
+ *
+ * @code
+ * constexpr auto methods = make_static_dictionary([] {
+ *     return std::array<std::pair<std::string_view, int>, 3>{{{"GET", 1}, {"POST", 2}, {"PUT", 3}}};
+ * });
+ * static_assert(*methods.word_exist("POST") == 2);
+ *
+ * constexpr auto keywords = make_static_dictionary([] {
+ *     return std::array<std::string_view, 3>{"select", "from", "where"};
+ * });
+ * static_assert(*keywords.word_exist("from") == 1); // position in the list
+ * @endcode
+ */
+
+/**
+ * @brief Orders keys the way `Dictionary` traverses them: by `std::less<char>`.
+ */
+constexpr bool static_key_less(std::string_view a, std::string_view b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+/**
+ * @brief The number of trie nodes needed for a set of keys, including the root.
+ * @param keys Sorted with `static_key_less`, without duplicates.
+ */
+template<std::size_t N>
+constexpr std::size_t static_trie_node_count(const std::array<std::string_view, N> &keys) {
+    std::size_t count = 1;
+    std::string_view prev;
+    for (std::string_view key : keys) {
+        auto shared = std::mismatch(prev.begin(), prev.end(), key.begin(), key.end()).first - prev.begin();
+        count += key.size() - static_cast<std::size_t>(shared);
+        prev = key;
+    }
+    return count;
+}
+
+/**
+ * @tparam V The literal value type associated with each key.
+ * @tparam WordCount The number of keys.
+ * @tparam NodeCount The number of trie nodes; see `static_trie_node_count`.
+ *         `make_static_dictionary` works both counts out from the key list.
+ */
+template<class V, std::size_t WordCount, std::size_t NodeCount>
+class StaticDictionary {
+public:
+    using entry_type = std::pair<std::string_view, V>;
+
+private:
+    struct Node {
+        /**
+         * @brief The character on the edge from the parent. Unused for the root.
+         */
+        char label = '\0';
+        /**
+         * @brief True if the word spelled by this node is a key; its entry is then `first_word`.
+         */
+        bool terminal = false;
+        /**
+         * @brief True if the node has children; the first one is then the node right after it.
+         */
+        bool has_children = false;
+        /**
+         * @brief The next child of the same parent, or 0 if this is the last one.
+         */
+        std::uint32_t next_sibling = 0;
+        /**
+         * @brief The entries of this subtree: `[first_word, end_word)`.
+         */
+        std::uint32_t first_word = 0;
+        std::uint32_t end_word = 0;
+    };
+
+    std::array<entry_type, WordCount> entries{};
+    std::array<Node, NodeCount> nodes{};
+
+    /**
+     * @brief Returns the node for `prefix`, or `NodeCount` if there is none.
+     */
+    constexpr std::size_t find(std::string_view prefix) const {
+        std::size_t cur = 0;
+        for (char c : prefix) {
+            // Children are the node right after `cur` and its sibling chain.
+            if (!nodes[cur].has_children) {
+                return NodeCount;
+            }
+            std::size_t child = cur + 1;
+            while (nodes[child].label != c) {
+                child = nodes[child].next_sibling;
+                if (child == 0) {
+                    return NodeCount;
+                }
+            }
+            cur = child;
+        }
+        return cur;
+    }
+
+public:
+    /**
+     * @brief Builds the trie. Intended for constant evaluation.
+     * @param input The keys and their values, in any order.
+     * @throws std::invalid_argument (a compile error in constant evaluation)
+     *         if a key repeats or `NodeCount` does not match the keys.
+     */
+    constexpr explicit StaticDictionary(std::array<entry_type, WordCount> input) : entries(input) {
+        std::sort(entries.begin(), entries.end(), [](const entry_type &a, const entry_type &b) {
+            return static_key_less(a.first, b.first);
+        });
+        // Nodes are appended in depth-first order; `stack` is the path of the previous key.
+        std::array<std::uint32_t, NodeCount> last_child{};
+        std::array<std::uint32_t, NodeCount> stack{};
+        std::size_t depth = 0;
+        std::size_t used = 1;
+        std::string_view prev;
+        for (std::size_t w = 0; w < WordCount; ++w) {
+            std::string_view key = entries[w].first;
+            if (w > 0 && key == prev) {
+                throw std::invalid_argument("duplicate key in static dictionary");
+            }
+            std::size_t shared = static_cast<std::size_t>(
+                std::mismatch(prev.begin(), prev.end(), key.begin(), key.end()).first - prev.begin());
+            for (; depth > shared; --depth) {
+                nodes[stack[depth]].end_word = static_cast<std::uint32_t>(w);
+            }
+            for (std::size_t i = shared; i < key.size(); ++i) {
+                if (used == NodeCount) {
+                    throw std::invalid_argument("static dictionary node count is too small");
+                }
+                std::uint32_t parent = stack[depth];
+                auto node = static_cast<std::uint32_t>(used++);
+                nodes[node].label = key[i];
+                nodes[node].first_word = static_cast<std::uint32_t>(w);
+                if (last_child[parent]) {
+                    nodes[last_child[parent]].next_sibling = node;
+                }
+                nodes[parent].has_children = true;
+                last_child[parent] = node;
+                stack[++depth] = node;
+            }
+            nodes[stack[depth]].terminal = true;
+            prev = key;
+        }
+        for (; depth > 0; --depth) {
+            nodes[stack[depth]].end_word = static_cast<std::uint32_t>(WordCount);
+        }
+        nodes[0].end_word = static_cast<std::uint32_t>(WordCount);
+        if (used != NodeCount) {
+            throw std::invalid_argument("static dictionary node count does not match its keys");
+        }
+    }
+
+    /**
+     * @brief The number of keys.
+     */
+    static constexpr std::size_t size() {
+        return WordCount;
+    }
+
+    /**
+     * @brief Checks if a word exists and returns a pointer to its value.
+     * @return A pointer to the value if the word is a key, otherwise nullptr.
+     */
+    constexpr const V* word_exist(std::string_view word) const {
+        std::size_t node = find(word);
+        return node != NodeCount && nodes[node].terminal ? &entries[nodes[node].first_word].second : nullptr;
+    }
+
+    /**
+     * @brief Checks if any key starts with `prefix`.
+     */
+    constexpr bool prefix_exist(std::string_view prefix) const {
+        return find(prefix) != NodeCount;
+    }
+
+    /**
+     * @brief All keys starting with `prefix` with their values, in `Dictionary` traversal order.
+     * @return A span over the sorted entries; empty if no key matches.
+     */
+    constexpr std::span<const entry_type> completions(std::string_view prefix) const {
+        std::size_t node = find(prefix);
+        if (node == NodeCount) {
+            return {};
+        }
+        return std::span<const entry_type>(entries).subspan(
+            nodes[node].first_word, nodes[node].end_word - nodes[node].first_word);
+    }
+
+    /**
+     * @brief The number of keys starting with `prefix`.
+     */
+    constexpr std::size_t count_prefix(std::string_view prefix) const {
+        return completions(prefix).size();
+    }
+
+    /**
+     * @brief Finds the values of all keys with a given prefix.
+     * @param res A vector to which pointers to the matching values will be added.
+     */
+    void auto_complete(std::string_view prefix, std::vector<const V*> &res) const {
+        for (const entry_type &entry : completions(prefix)) {
+            res.push_back(&entry.second);
+        }
+    }
+
+    /**
+     * @brief Applies a function to every value, in `Dictionary` traversal order.
+     * @param func Called with a `const V*` for each key.
+     */
+    template<typename Func>
+    constexpr void traverse(Func func) const {
+        for (const entry_type &entry : entries) {
+            func(&entry.second);
+        }
+    }
+
+    /**
+     * @brief Like `traverse`, also passing each key.
+     * @param func Called with `(std::string_view key, const V* value)`.
+     */
+    template<typename Func>
+    constexpr void traverse_with_keys(Func func) const {
+        for (const entry_type &entry : entries) {
+            func(entry.first, &entry.second);
+        }
+    }
+};
+
+/**
+ * @brief True for the keys-only input form of `make_static_dictionary`.
+ */
+template<class T>
+struct is_static_key_list : std::false_type {};
+
+template<std::size_t N>
+struct is_static_key_list<std::array<std::string_view, N>> : std::true_type {};
+
+/**
+ * @brief The keys of a `make_static_dictionary` input, sorted with `static_key_less`.
+ */
+template<class Entries>
+constexpr auto static_sorted_keys(const Entries &input) {
+    std::array<std::string_view, std::tuple_size_v<Entries>> keys{};
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if constexpr (is_static_key_list<Entries>::value) {
+            keys[i] = input[i];
+        } else {
+            keys[i] = input[i].first;
+        }
+    }
+    std::sort(keys.begin(), keys.end(), static_key_less);
+    return keys;
+}
+
+/**
+ * @brief Builds a `StaticDictionary` at compile time, sizing it from the keys.
+ * @tparam Make A captureless lambda (or other default-constructible callable)
+ *         returning the key set as either
+ *         - `std::array<std::pair<std::string_view, V>, N>`: keys with values, or
+ *         - `std::array<std::string_view, N>`: keys only; each key's value is its
+ *           `std::size_t` position in the list.
+ * @note Keys are string views, so they must refer to storage with static
+ *       duration, such as string literals.
+ */
+template<class Make>
+consteval auto make_static_dictionary(Make) {
+    constexpr auto input = Make{}();
+    using Entries = std::remove_cvref_t<decltype(input)>;
+    constexpr std::size_t word_count = std::tuple_size_v<Entries>;
+    constexpr std::size_t node_count =
+        static_trie_node_count(static_sorted_keys(input));
+    if constexpr (is_static_key_list<Entries>::value) {
+        std::array<std::pair<std::string_view, std::size_t>, word_count> entries{};
+        for (std::size_t i = 0; i < word_count; ++i) {
+            entries[i] = {input[i], i};
+        }
+        return StaticDictionary<std::size_t, word_count, node_count>(entries);
+    } else {
+        using V = typename Entries::value_type::second_type;
+        return StaticDictionary<V, word_count, node_count>(input);
+    }
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include "input_utils.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <utility>
+#include <cerrno>
+#include <system_error>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#error "async_input.hpp requires POSIX poll(); it is not available on Windows"
+#endif
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+/**
+ * @file async_input.hpp
+ * @brief Coroutine-based validated input for programs driven by an event loop.
+ * @details `read_validated_input_async` behaves like `read_validated_input`,
+ *          but instead of blocking in `std::getline` it suspends until an
+ *          `AsyncLineReader` has a full line. The reader never blocks: the
+ *          event loop watches `reader.fd()` and calls `on_readable()` when it
+ *          is readable, or calls `poll(timeout)` when it has nothing else to do.
+ *
+ * @code
+ * AsyncLineReader console(STDIN_FILENO);
+ * auto port = read_validated_input_async<int>(console, std::cout, "Port: ", 0,
+ *                                             validators::between(1, 65535));
+ * while (!port.done()) {
+ *     console.poll(10);
+ *     run_other_work();
+ * }
+ * int p = port.get();
+ * @endcode
+ */
+
+/**
+ * @brief The result of a coroutine that reads input: awaitable, or polled with `done()` and `get()`.
+ * @details The coroutine starts running as soon as it is called, so the
+ *          prompt is written immediately, and runs until it needs a line that
+ *          has not arrived yet. Awaiting the task from another coroutine
+ *          resumes that coroutine once the value is read.
+ */
+template<class T>
+class InputTask {
+public:
+    struct promise_type {
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+
+        InputTask get_return_object() {
+            return InputTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        /**
+         * @brief Resumes the awaiting coroutine, if any, when the task finishes.
+         */
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::coroutine_handle<> next = h.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        template<class U>
+        void return_value(U&& result) {
+            value.emplace(std::forward<U>(result));
+        }
+
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+    };
+
+    InputTask(InputTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    InputTask& operator=(InputTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    InputTask(const InputTask&) = delete;
+    InputTask& operator=(const InputTask&) = delete;
+
+    ~InputTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /**
+     * @brief True once a valid value was read or the read failed.
+     */
+    bool done() const {
+        return handle && handle.done();
+    }
+
+    /**
+     * @brief The value read.
+     * @throws std::logic_error if the task is not done, or whatever the read threw.
+     */
+    T get() {
+        if (!done()) {
+            throw std::logic_error("input task is not done");
+        }
+        if (handle.promise().error) {
+            std::rethrow_exception(handle.promise().error);
+        }
+        return std::move(*handle.promise().value);
+    }
+
+    bool await_ready() const {
+        return done();
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        handle.promise().continuation = awaiting;
+    }
+
+    T await_resume() {
+        return get();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit InputTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+};
+
+/**
+ * @brief Splits a file descriptor into lines without ever blocking.
+ * @details The descriptor is switched to non-blocking mode for the reader's
+ *          lifetime and restored afterwards. Lines are read straight from the
+ *          descriptor, so do not also read it through `std::cin` or `stdin`
+ *          while a reader exists: each would steal the other's buffered input.
+ *          One coroutine at a time may wait on a reader.
+ */
+class AsyncLineReader {
+private:
+    int descriptor;
+    int saved_flags;
+    std::string buffer;
+    /**
+     * @brief Where to resume looking for a newline: `buffer` before it has none.
+     */
+    std::size_t scanned = 0;
+    bool at_eof = false;
+    std::coroutine_handle<> waiter;
+
+    /**
+     * @brief Moves the next complete line, or the unterminated rest at end of input, into `line`.
+     */
+    bool take_line(std::string& line) {
+        std::size_t newline = buffer.find('\n', scanned);
+        if (newline == std::string::npos) {
+            scanned = buffer.size();
+            if (!at_eof || buffer.empty()) {
+                return false;
+            }
+            newline = buffer.size();
+        }
+        line.assign(buffer, 0, newline);
+        buffer.erase(0, std::min(newline + 1, buffer.size()));
+        scanned = 0;
+        return true;
+    }
+
+    bool line_ready() const {
+        return at_eof || buffer.find('\n', scanned) != std::string::npos;
+    }
+
+public:
+    /**
+     * @param fd An open descriptor, e.g. `STDIN_FILENO` or a socket. It is not closed.
+     * @throws std::system_error if the descriptor's flags cannot be changed.
+     */
+    explicit AsyncLineReader(int fd) : descriptor(fd), saved_flags(::fcntl(fd, F_GETFL)) {
+        if (saved_flags == -1 || ::fcntl(fd, F_SETFL, saved_flags | O_NONBLOCK) == -1) {
+            throw std::system_error(errno, std::generic_category(), "cannot make descriptor non-blocking");
+        }
+    }
+
+    AsyncLineReader(const AsyncLineReader&) = delete;
+    AsyncLineReader& operator=(const AsyncLineReader&) = delete;
+
+    ~AsyncLineReader() {
+        ::fcntl(descriptor, F_SETFL, saved_flags);
+    }
+
+    /**
+     * @brief The descriptor to watch for readability in the event loop.
+     */
+    int fd() const {
+        return descriptor;
+    }
+
+    /**
+     * @brief True once the descriptor reported end of input.
+     */
+    bool eof() const {
+        return at_eof;
+    }
+
+    /**
+     * @brief True if a coroutine is suspended waiting for a line.
+     */
+    bool waiting() const {
+        return static_cast<bool>(waiter);
+    }
+
+    /**
+     * @brief Reads whatever is available and resumes the waiting coroutine if its line is complete.
+     * @details Call when the event loop reports the descriptor readable. The
+     *          waiting coroutine runs inside this call, up to its next suspension.
+     * @throws std::system_error if reading fails.
+     */
+    void on_readable() {
+        char chunk[4096];
+        while (!at_eof) {
+            ssize_t n = ::read(descriptor, chunk, sizeof(chunk));
+            if (n > 0) {
+                buffer.append(chunk, static_cast<std::size_t>(n));
+            } else if (n == 0) {
+                at_eof = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else {
+                throw std::system_error(errno, std::generic_category(), "read failed");
+            }
+        }
+        if (waiter && line_ready()) {
+            std::exchange(waiter, nullptr).resume();
+        }
+    }
+
+    /**
+     * @brief Waits up to `timeout_ms` for input, then handles it as `on_readable` does.
+     * @param timeout_ms As for `poll(2)`: 0 returns at once, -1 waits indefinitely.
+     * @return True if the descriptor was readable.
+     * @throws std::system_error if polling or reading fails.
+     */
+    bool poll(int timeout_ms) {
+        if (at_eof) {
+            on_readable();
+            return true;
+        }
+        pollfd entry{descriptor, POLLIN, 0};
+        int ready = ::poll(&entry, 1, timeout_ms);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                return false;
+            }
+            throw std::system_error(errno, std::generic_category(), "poll failed");
+        }
+        if (ready == 0) {
+            return false;
+        }
+        on_readable();
+        return true;
+    }
+
+    /**
+     * @brief Awaits the next line: `co_await reader.next_line()`.
+     * @return The line without its newline, or `std::nullopt` at end of input.
+     *         Completes without suspending if a line is already buffered.
+     * @throws std::logic_error if another coroutine is already waiting.
+     */
+    auto next_line() {
+        struct Awaiter {
+            AsyncLineReader& reader;
+            std::string line;
+            bool taken = false;
+
+            bool await_ready() {
+                taken = reader.take_line(line);
+                return taken || reader.at_eof;
+            }
+
+            void await_suspend(std::coroutine_handle<> h) {
+                if (reader.waiter) {
+                    throw std::logic_error("another coroutine is already waiting on this reader");
+                }
+                reader.waiter = h;
+            }
+
+            std::optional<std::string> await_resume() {
+                if (taken || reader.take_line(line)) {
+                    return std::move(line);
+                }
+                return std::nullopt;
+            }
+        };
+        return Awaiter{*this, {}, false};
+    }
+};
+
+/**
+ * @brief Reads and validates a value without blocking, for use in an event loop.
+ *
+ * The coroutine counterpart of `read_validated_input`: it writes the prompt,
+ * then suspends until `reader` delivers a line, re-prompting with
+ * `error_message` until a value parses and passes `validator`.
+ *
+ * @tparam T The data type of the value to be read.
+ * @param reader The source of lines; it must outlive the task.
+ * @param out The stream the prompt and error messages are written to; it must outlive the task. Flushed after each write.
+ * @param prompt The message to display to the user.
+ * @param indent_tabs The number of tabs to indent the prompt and messages.
+ * @param validator As for `read_validated_input`. Copied into the coroutine.
+ * @param error_message The error message to display for invalid values.
+ * @return A task yielding the validated value. Its `get()` (or `co_await`)
+ *         throws std::runtime_error if the input ends before a valid value is read.
+ * @note The strings and validator are taken by value because the coroutine
+ *       outlives the call that starts it.
+ */
+template<typename T, InputValidator<T> Validator = std::nullptr_t>
+InputTask<T> read_validated_input_async(AsyncLineReader& reader, std::ostream& out, std::string prompt,
+                                        int indent_tabs = 0, Validator validator = nullptr,
+                                        std::string error_message = "Invalid value. Please try again.\n") {
+    T value{};
+    std::string indent(indent_tabs, '\t');
+    out << indent << prompt << std::flush;
+    indent.push_back('\t');
+    while (true) {
+        std::optional<std::string> line = co_await reader.next_line();
+        if (!line) {
+            throw std::runtime_error("input ended before a valid value was read");
+        }
+
+        if (input_parser<T>::parse(*line, value)) {
+            if (passes_validation(validator, value)) {
+                co_return value;
+            }
+            out << indent << error_message << std::flush;
+        } else {
+            out << indent << "Invalid format. Please try again.\n" << std::flush;
+        }
+    }
+}
@@ -3,13 +3,369 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <functional>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+#include <system_error>
+#include <stdexcept>
+#include <concepts>
+#include <regex>
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 /**
  * @file input_utils.hpp
  * @brief A utility for reading and validating user input from the console.
  */
 
+/**
+ * @brief True for the arithmetic types `std::from_chars` parses as numbers.
+ * @details `bool` and the character types are excluded: `operator>>` reads
+ *          those as `0`/`1` and as single characters, so they keep the stream path.
+ */
+template<typename T>
+concept FromCharsNumber = (std::is_integral_v<T> || std::is_floating_point_v<T>) &&
+                          !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+                          !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> &&
+                          !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+                          !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+/**
+ * @brief A validator for values of type `T`: any predicate callable with a
+ *        `const T&`, or `nullptr` for no validation.
+ * @details Validators are taken by template parameter, so lambdas and the
+ *          combinators in `validators` are inlined instead of being called
+ *          through a type-erased `std::function`. A `std::function` or function
+ *          pointer still works; an empty one means no validation.
+ */
+template<typename V, typename T>
+concept InputValidator = std::is_null_pointer_v<V> || std::predicate<const V&, const T&>;
+
+/**
+ * @brief Applies a validator; `nullptr` and empty nullable callables accept everything.
+ */
+template<typename T, typename Validator>
+bool passes_validation(const Validator& validator, const T& value) {
+    if constexpr (std::is_null_pointer_v<Validator>) {
+        return true;
+    } else {
+        if constexpr (requires { validator == nullptr; }) {
+            if (validator == nullptr) {
+                return true;
+            }
+        }
+        return static_cast<bool>(validator(value));
+    }
+}
+
+/**
+ * @brief Composable validators for `read_validated_input` and `read_validated_batch`.
+ * @details Each factory returns a small predicate object; `&&`, `||` and `!`
+ *          combine them into one object whose check the compiler fuses into
+ *          straight-line code:
+ * @code
+ * auto port = validators::between(1, 65535) && !validators::one_of(22, 25);
+ * int p = read_validated_input<int>("Port: ", 0, port);
+ * @endcode
+ */
+namespace validators {
+
+/**
+ * @brief Base of every combinator; opts the type into `&&`, `||` and `!`.
+ */
+template<class Derived>
+struct Combinable {};
+
+template<class V>
+concept combinable = std::derived_from<V, Combinable<V>>;
+
+/**
+ * @brief Wraps any predicate so it can be combined with the other validators.
+ */
+template<class F>
+struct Predicate : Combinable<Predicate<F>> {
+    F f;
+    constexpr explicit Predicate(F f) : f(std::move(f)) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return static_cast<bool>(f(value)); }
+};
+
+template<class F>
+constexpr Predicate<F> satisfies(F f) {
+    return Predicate<F>(std::move(f));
+}
+
+template<class A, class B>
+struct AllOf : Combinable<AllOf<A, B>> {
+    A a;
+    B b;
+    constexpr AllOf(A a, B b) : a(std::move(a)), b(std::move(b)) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return a(value) && b(value); }
+};
+
+template<class A, class B>
+struct AnyOf : Combinable<AnyOf<A, B>> {
+    A a;
+    B b;
+    constexpr AnyOf(A a, B b) : a(std::move(a)), b(std::move(b)) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return a(value) || b(value); }
+};
+
+template<class A>
+struct NoneOf : Combinable<NoneOf<A>> {
+    A a;
+    constexpr explicit NoneOf(A a) : a(std::move(a)) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return !a(value); }
+};
+
+template<combinable A, combinable B>
+constexpr AllOf<A, B> operator&&(A a, B b) {
+    return AllOf<A, B>(std::move(a), std::move(b));
+}
+
+template<combinable A, combinable B>
+constexpr AnyOf<A, B> operator||(A a, B b) {
+    return AnyOf<A, B>(std::move(a), std::move(b));
+}
+
+template<combinable A>
+constexpr NoneOf<A> operator!(A a) {
+    return NoneOf<A>(std::move(a));
+}
+
+/**
+ * @brief Accepts values in the closed interval `[low, high]`.
+ * @details Values unordered with the bounds, such as a floating-point NaN, are rejected.
+ */
+template<class L>
+struct Between : Combinable<Between<L>> {
+    L low;
+    L high;
+    constexpr Between(L low, L high) : low(std::move(low)), high(std::move(high)) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return low <= value && value <= high; }
+};
+
+template<class L>
+constexpr Between<L> between(L low, L high) {
+    return Between<L>(std::move(low), std::move(high));
+}
+
+/**
+ * @brief Accepts values equal to one of the given candidates.
+ */
+template<class... Cs>
+struct OneOf : Combinable<OneOf<Cs...>> {
+    std::tuple<Cs...> candidates;
+    constexpr explicit OneOf(Cs... cs) : candidates(std::move(cs)...) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const {
+        return std::apply([&value](const auto&... c) { return ((value == c) || ...); }, candidates);
+    }
+};
+
+template<class... Cs>
+constexpr OneOf<std::decay_t<Cs>...> one_of(Cs&&... cs) {
+    return OneOf<std::decay_t<Cs>...>(std::forward<Cs>(cs)...);
+}
+
+/**
+ * @brief Accepts strings or containers whose `size()` is in `[min, max]`.
+ */
+struct LengthBetween : Combinable<LengthBetween> {
+    std::size_t min;
+    std::size_t max;
+    constexpr LengthBetween(std::size_t min, std::size_t max) : min(min), max(max) {}
+    template<class T>
+    constexpr bool operator()(const T& value) const { return value.size() >= min && value.size() <= max; }
+};
+
+constexpr LengthBetween length_between(std::size_t min, std::size_t max) {
+    return LengthBetween(min, max);
+}
+
+/**
+ * @brief Accepts strings that match a regular expression in full.
+ * @details The expression is compiled once, when the validator is made, and
+ *          shared by its copies.
+ */
+struct Matches : Combinable<Matches> {
+    std::shared_ptr<const std::regex> pattern;
+    explicit Matches(const std::string& expression)
+        : pattern(std::make_shared<const std::regex>(expression, std::regex::optimize)) {}
+    bool operator()(const std::string& value) const { return std::regex_match(value, *pattern); }
+};
+
+inline Matches matches(const std::string& expression) {
+    return Matches(expression);
+}
+
+} // namespace validators
+
+/**
+ * @brief Returns `text` without its leading whitespace, as `operator>>` would skip it.
+ */
+inline std::string_view skip_leading_space(std::string_view text) {
+    std::size_t i = text.find_first_not_of(" \t\n\v\f\r");
+    return i == std::string_view::npos ? std::string_view() : text.substr(i);
+}
+
+/**
+ * @brief Customization point: parses one line of input into a `T`.
+ * @details `parse(text, value)` returns true if the whole of `text`, after
+ *          leading whitespace, is a valid `T`. The primary template uses
+ *          `operator>>`, so any streamable type works; specialize it to give
+ *          your own types a faster or stricter parser.
+ */
+template<typename T>
+struct input_parser {
+    static bool parse(std::string_view text, T& value) {
+        std::istringstream ss{std::string(text)};
+        return (ss >> value) && ss.eof();
+    }
+};
+
+/**
+ * @brief Numbers are parsed with `std::from_chars`: no stream, no locale, no allocation.
+ * @note A leading `+` is accepted, as with `operator>>`; unlike `operator>>`,
+ *       a leading `-` is rejected for unsigned types instead of wrapping around.
+ *       `from_chars` also reads "nan", "inf" and "infinity", which are rejected
+ *       so that floating-point input stays finite. `value` is only written on success.
+ */
+template<FromCharsNumber T>
+struct input_parser<T> {
+    static bool parse(std::string_view text, T& value) {
+        text = skip_leading_space(text);
+        if (text.size() > 1 && text[0] == '+' && text[1] != '-' && text[1] != '+') {
+            text.remove_prefix(1);
+        }
+        const char* last = text.data() + text.size();
+        T parsed{};
+        auto [end, error] = std::from_chars(text.data(), last, parsed);
+        if (error != std::errc() || end != last) {
+            return false;
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(parsed)) {
+                return false;
+            }
+        }
+        value = parsed;
+        return true;
+    }
+};
+
+/**
+ * @brief Strings take the line as-is: one whitespace-free word, as `operator>>` reads it.
+ * @details Assigns into `value`, so a buffer reused across parses keeps its capacity.
+ */
+template<>
+struct input_parser<std::string> {
+    static bool parse(std::string_view text, std::string& value) {
+        text = skip_leading_space(text);
+        if (text.empty() || text.find_first_of(" \t\n\v\f\r") != std::string_view::npos) {
+            return false;
+        }
+        value.assign(text);
+        return true;
+    }
+};
+
+/**
+ * @brief When `read_validated_input` pushes its prompts and messages out.
+ */
+enum class PromptFlush {
+    /**
+     * @brief Flush after every prompt and message, so they appear before input is awaited.
+     */
+    Always,
+    /**
+     * @brief Never flush, and untie the input stream from its output for the
+     *        duration of the call; output leaves when the stream's buffer fills
+     *        or the caller flushes. For scripted or load-test input nobody reads live.
+     */
+    Buffered
+};
+
+/**
+ * @brief Reads and validates a value from any input stream, prompting on any output stream.
+ *
+ * This is the general form of the console overload below: it reads lines from
+ * `in` and writes the prompt and error messages to `out`, so it can be driven
+ * from memory (`std::istringstream`, `std::ispanstream`), files, or any
+ * `std::streambuf` such as one wrapping a socket.
+ *
+ * @tparam T The data type of the value to be read.
+ * @param in The stream to read lines from.
+ * @param out The stream the prompt and error messages are written to.
+ * @param prompt The message to display to the user.
+ * @param indent_tabs The number of tabs to indent the prompt and messages.
+ * @param validator A callable (function, lambda, combinator from `validators`, etc.)
+ *                  that takes a value of type T and returns true if the value is
+ *                  valid, false otherwise. If nullptr, no validation is performed.
+ * @param error_message The error message to display for invalid values.
+ * @param flush Whether prompts are flushed as they are written; see `PromptFlush`.
+ * @return The validated value of type T.
+ * @throws std::runtime_error if the input ends before a valid value is read.
+ */
+template<typename T, InputValidator<T> Validator = std::nullptr_t>
+T read_validated_input(std::istream& in, std::ostream& out, const std::string& prompt, int indent_tabs = 0,
+                       const Validator& validator = nullptr,
+                       const std::string& error_message = "Invalid value. Please try again.\n",
+                       PromptFlush flush = PromptFlush::Always) {
+    // Restores the stream's tie on every exit path.
+    struct TieGuard {
+        std::istream& in;
+        std::ostream* tied;
+        ~TieGuard() { in.tie(tied); }
+    } guard{in, flush == PromptFlush::Buffered ? in.tie(nullptr) : in.tie()};
+
+    auto write = [&out, flush](const std::string& indent, const std::string& text) {
+        out << indent << text;
+        if (flush == PromptFlush::Always) {
+            out.flush();
+        }
+    };
+
+    T value{};
+    std::string line;
+    std::string indent(indent_tabs, '\t');
+    write(indent, prompt);
+    indent.push_back('\t');
+    while (true) {
+        if (!std::getline(in, line)) {
+            throw std::runtime_error("input ended before a valid value was read");
+        }
+
+        if (input_parser<T>::parse(line, value)) {
+            //if there is a validation function, then use it
+            if (passes_validation(validator, value)) {
+                break; // input is valid
+            } else {
+                write(indent, error_message);
+            }
+        } else {
+            write(indent, "Invalid format. Please try again.\n");
+        }
+    }
+    return value;
+}
+
 /**
  * @brief Reads and validates user input from the console.
  *
@@ -17,38 +373,521 @@
  * and attempts to parse it into the specified type `T`. It can optionally
  * validate the parsed value using a provided validator function.
  *
+ * Parsing goes through `input_parser<T>`: `std::from_chars` for numbers, a
+ * direct copy for `std::string`, and `operator>>` for everything else.
+ *
  * @tparam T The data type of the value to be read.
  * @param prompt The message to display to the user.
  * @param indent_tabs The number of tabs to indent the prompt and messages.
- * @param validator A callable (function, lambda, etc.) that takes a value of type T
- *                  and returns true if the value is valid, false otherwise.
- *                  If nullptr, no validation is performed.
+ * @param validator A callable (function, lambda, combinator from `validators`, etc.)
+ *                  that takes a value of type T and returns true if the value is
+ *                  valid, false otherwise. If nullptr, no validation is performed.
  * @param error_message The error message to display for invalid values.
  * @return The validated value of type T.
+ * @throws std::runtime_error if standard input ends before a valid value is read.
  */
-template<typename T>
+template<typename T, InputValidator<T> Validator = std::nullptr_t>
 T read_validated_input(const std::string& prompt, int indent_tabs = 0,
-                       const std::function<bool(const T&)>& validator = nullptr,
+                       const Validator& validator = nullptr,
                        const std::string& error_message = "Invalid value. Please try again.\n") {
-    T value;
+    return read_validated_input<T, Validator>(std::cin, std::cout, prompt, indent_tabs, validator, error_message);
+}
+
+/**
+ * @brief Passed as the count to `read_validated_batch` to read until end of input.
+ */
+inline constexpr std::size_t read_until_eof = static_cast<std::size_t>(-1);
+
+/**
+ * @brief A token that `read_validated_batch` rejected.
+ */
+struct InputError {
+    /**
+     * @brief The 1-based line the token started on.
+     */
+    std::size_t line;
+    std::string token;
+    std::string message;
+};
+
+/**
+ * @brief The outcome of a `read_validated_batch` call.
+ */
+struct BatchReadResult {
+    /**
+     * @brief The number of values written to the output.
+     */
+    std::size_t values = 0;
+    /**
+     * @brief The rejected tokens, in input order.
+     */
+    std::vector<InputError> errors;
+};
+
+/**
+ * @brief True if `in` is `std::cin` attached to a terminal, i.e. someone may be typing.
+ */
+inline bool is_interactive(const std::istream& in) {
+    if (&in != &std::cin) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _isatty(_fileno(stdin)) != 0;
+#else
+    return ::isatty(::fileno(stdin)) != 0;
+#endif
+}
+
+/**
+ * @brief Reads many whitespace-separated values at once, collecting errors instead of re-prompting.
+ *
+ * Meant for piped or redirected input. When reading to end of input from a
+ * non-interactive stream, the input is read in large blocks and tokens are
+ * parsed in place, so no per-token allocation or flush happens; otherwise it
+ * is read a line at a time, so that a terminal user is not kept waiting for a
+ * full block and no input past the last requested value's line is consumed.
+ *
+ * @tparam T The data type of the values to be read.
+ * @tparam OutputIt An output iterator accepting `T`, e.g. `std::back_inserter(vec)`.
+ * @param in The stream to read from.
+ * @param count The number of valid values to read, or `read_until_eof`.
+ * @param validator Returns true if a parsed value is acceptable. If nullptr,
+ *                  every value that parses is accepted.
+ * @param out Receives each accepted value, in input order.
+ * @param prompt Written once before reading, and only if `in` is an interactive `std::cin`.
+ * @param error_message The message recorded for values the validator rejects.
+ * @return The number of values read and the rejected tokens with their line numbers.
+ */
+template<typename T, InputValidator<T> Validator, typename OutputIt>
+BatchReadResult read_validated_batch(std::istream& in, std::size_t count,
+                                     const Validator& validator, OutputIt out,
+                                     const std::string& prompt = "",
+                                     const std::string& error_message = "Invalid value.") {
+    static constexpr std::string_view spaces = " \t\n\v\f\r";
+    BatchReadResult result;
+    bool interactive = is_interactive(in);
+    if (interactive && !prompt.empty()) {
+        std::cout << prompt << std::flush;
+    }
+    T value{};
+    // Parses one token; returns true once `count` values have been read.
+    auto accept = [&](std::string_view token, std::size_t line) {
+        if (!input_parser<T>::parse(token, value)) {
+            result.errors.push_back({line, std::string(token), "Invalid format."});
+        } else if (!passes_validation(validator, value)) {
+            result.errors.push_back({line, std::string(token), error_message});
+        } else {
+            *out = value;
+            ++out;
+            ++result.values;
+        }
+        return result.values == count;
+    };
+
+    std::size_t line = 1;
+    if (count == read_until_eof && !interactive) {
+        std::vector<char> block(64 * 1024);
+        // A token cut off by the end of a block, and the line it started on.
+        std::string carry;
+        std::size_t carry_line = 0;
+        while (in.read(block.data(), static_cast<std::streamsize>(block.size())) || in.gcount() > 0) {
+            std::string_view text(block.data(), static_cast<std::size_t>(in.gcount()));
+            std::size_t i = 0;
+            if (!carry.empty()) {
+                std::size_t end = std::min(text.find_first_of(spaces), text.size());
+                carry.append(text.substr(0, end));
+                if (end == text.size()) {
+                    continue;
+                }
+                accept(carry, carry_line);
+                carry.clear();
+                i = end;
+            }
+            while (i < text.size()) {
+                while (i < text.size() && spaces.find(text[i]) != std::string_view::npos) {
+                    line += text[i] == '\n';
+                    ++i;
+                }
+                std::size_t start = i;
+                i = std::min(text.find_first_of(spaces, start), text.size());
+                if (i == text.size()) {
+                    carry.assign(text.substr(start));
+                    carry_line = line;
+                    break;
+                }
+                accept(text.substr(start, i - start), line);
+            }
+        }
+        if (!carry.empty()) {
+            accept(carry, carry_line);
+        }
+        return result;
+    }
+
+    std::string buffer;
+    for (; result.values < count && std::getline(in, buffer); ++line) {
+        std::string_view text(buffer);
+        std::size_t i = 0;
+        while ((i = text.find_first_not_of(spaces, i)) != std::string_view::npos) {
+            std::size_t end = std::min(text.find_first_of(spaces, i), text.size());
+            if (accept(text.substr(i, end - i), line)) {
+                break;
+            }
+            i = end;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief How `read_validated_record` and `read_validated_records` split a line into fields.
+ */
+struct RecordFormat {
+    /**
+     * @brief The field separator; `'\0'` splits on runs of whitespace.
+     */
+    char delimiter = '\0';
+    /**
+     * @brief Fields may be enclosed in double quotes, with `""` for a literal quote, as in CSV.
+     */
+    bool quoted = false;
+    /**
+     * @brief Strip whitespace around each delimited field.
+     */
+    bool trim = true;
+
+    static constexpr RecordFormat whitespace() { return {}; }
+    static constexpr RecordFormat csv() { return {',', true, true}; }
+    static constexpr RecordFormat tsv() { return {'\t', false, false}; }
+};
+
+/**
+ * @brief Walks the fields of one line in place, according to a `RecordFormat`.
+ * @details Unquoted fields are views into the line; only a quoted field with
+ *          an escaped quote is copied, into a buffer reused across fields.
+ */
+class RecordCursor {
+private:
+    static constexpr std::string_view spaces = " \t\n\v\f\r";
+
+    std::string_view line;
+    RecordFormat format;
+    std::size_t pos = 0;
+    bool finished = false;
+    bool bad = false;
+    std::string unquoted;
+
+    std::string_view trimmed(std::string_view field) const {
+        if (!format.trim) {
+            return field;
+        }
+        std::size_t first = field.find_first_not_of(spaces);
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return field.substr(first, field.find_last_not_of(spaces) - first + 1);
+    }
+
+    bool next_quoted(std::string_view& field) {
+        unquoted.clear();
+        std::size_t i = pos + 1;
+        while (true) {
+            std::size_t quote = line.find('"', i);
+            if (quote == std::string_view::npos) {
+                bad = true;
+                return false;
+            }
+            unquoted.append(line.substr(i, quote - i));
+            if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                unquoted.push_back('"');
+                i = quote + 2;
+                continue;
+            }
+            i = quote + 1;
+            break;
+        }
+        while (i < line.size() && line[i] != format.delimiter && spaces.find(line[i]) != std::string_view::npos) {
+            ++i;
+        }
+        if (i == line.size()) {
+            finished = true;
+        } else if (line[i] == format.delimiter) {
+            pos = i + 1;
+        } else {
+            bad = true;
+            return false;
+        }
+        field = unquoted;
+        return true;
+    }
+
+public:
+    RecordCursor(std::string_view line, const RecordFormat& format) : line(line), format(format) {}
+
+    /**
+     * @brief Moves to the next field.
+     * @return False once there are no more fields, or if the line is malformed.
+     */
+    bool next(std::string_view& field) {
+        if (finished || bad) {
+            return false;
+        }
+        if (format.delimiter == '\0') {
+            pos = line.find_first_not_of(spaces, pos);
+            if (pos == std::string_view::npos) {
+                finished = true;
+                return false;
+            }
+            std::size_t end = std::min(line.find_first_of(spaces, pos), line.size());
+            field = line.substr(pos, end - pos);
+            pos = end;
+            return true;
+        }
+        if (format.quoted) {
+            std::size_t first = line.find_first_not_of(" \t", pos);
+            if (first != std::string_view::npos && line[first] == '"' && format.delimiter != '"') {
+                pos = first;
+                return next_quoted(field);
+            }
+        }
+        std::size_t end = line.find(format.delimiter, pos);
+        if (end == std::string_view::npos) {
+            field = trimmed(line.substr(pos));
+            finished = true;
+        } else {
+            field = trimmed(line.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief True if a quoted field was unterminated or followed by stray text.
+     */
+    bool malformed() const {
+        return bad;
+    }
+};
+
+/**
+ * @brief Why a line did not make a valid record.
+ */
+enum class RecordStatus {
+    Ok,
+    /**
+     * @brief The line has more or fewer fields than the record, or broken quoting.
+     */
+    WrongFieldCount,
+    /**
+     * @brief A field did not parse as its type.
+     */
+    InvalidFormat,
+    /**
+     * @brief A field parsed but its validator rejected it.
+     */
+    Rejected
+};
+
+/**
+ * @brief True if `Validators` is `std::tuple<>` (no validation) or a tuple
+ *        holding one `InputValidator` per field of `Fields`.
+ */
+template<class Fields, class Validators>
+inline constexpr bool record_validators_v = false;
+
+template<class... Ts>
+inline constexpr bool record_validators_v<std::tuple<Ts...>, std::tuple<>> = true;
+
+template<class... Ts, class... Vs>
+    requires (sizeof...(Vs) > 0 && sizeof...(Ts) == sizeof...(Vs))
+inline constexpr bool record_validators_v<std::tuple<Ts...>, std::tuple<Vs...>> = (InputValidator<Vs, Ts> && ...);
+
+/**
+ * @brief Parses one field of a record; a string field takes the field text as-is.
+ */
+template<typename T>
+bool parse_record_field(std::string_view field, T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        value.assign(field);
+        return true;
+    } else {
+        return input_parser<T>::parse(field, value);
+    }
+}
+
+/**
+ * @brief Parses a whole line into `record`, dispatching each field to its type's parser at compile time.
+ * @param failed_field Set to the 1-based field that failed, or 0.
+ */
+template<typename... Ts, typename Validators, std::size_t... I>
+RecordStatus parse_record(std::string_view line, const RecordFormat& format, std::tuple<Ts...>& record,
+                          const Validators& validators, std::size_t& failed_field, std::index_sequence<I...>) {
+    RecordCursor cursor(line, format);
+    RecordStatus status = RecordStatus::Ok;
+    failed_field = 0;
+    auto field_ok = [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>) {
+        std::string_view field;
+        if (!cursor.next(field)) {
+            status = RecordStatus::WrongFieldCount;
+            return false;
+        }
+        auto& value = std::get<Index>(record);
+        if (!parse_record_field(field, value)) {
+            status = RecordStatus::InvalidFormat;
+        } else if constexpr (std::tuple_size_v<Validators> > 0) {
+            if (!passes_validation(std::get<Index>(validators), value)) {
+                status = RecordStatus::Rejected;
+            }
+        }
+        if (status != RecordStatus::Ok) {
+            failed_field = Index + 1;
+            return false;
+        }
+        return true;
+    };
+    if (!(field_ok(std::integral_constant<std::size_t, I>{}) && ...)) {
+        return status;
+    }
+    std::string_view extra;
+    if (cursor.next(extra) || cursor.malformed()) {
+        return RecordStatus::WrongFieldCount;
+    }
+    return RecordStatus::Ok;
+}
+
+/**
+ * @brief The message for a record that failed to parse or validate.
+ */
+inline std::string record_error_message(RecordStatus status, std::size_t field, std::size_t field_count,
+                                        const std::string& rejected_message) {
+    switch (status) {
+        case RecordStatus::WrongFieldCount:
+            return "Expected " + std::to_string(field_count) + " fields.";
+        case RecordStatus::InvalidFormat:
+            return "Invalid format in field " + std::to_string(field) + ".";
+        default:
+            return rejected_message;
+    }
+}
+
+/**
+ * @brief Reads and validates a multi-field record, such as "id name score", from one line.
+ *
+ * The whole line is split and every field parsed in one pass, instead of one
+ * `read_validated_input` call per field. If any field is missing, malformed
+ * or rejected, the user is told which and re-prompted for the whole record.
+ * To fill an aggregate, pass the result to `std::make_from_tuple<Aggregate>`.
+ *
+ * @tparam Ts The field types, in line order.
+ * @param in The stream to read lines from.
+ * @param out The stream the prompt and error messages are written to.
+ * @param prompt The message to display to the user.
+ * @param indent_tabs The number of tabs to indent the prompt and messages.
+ * @param validators `std::tuple<>` for none, or one validator per field (each
+ *                   may be nullptr), e.g. `std::tuple(nullptr, validators::length_between(1, 20))`.
+ * @param error_message The error message to display for rejected fields.
+ * @param format How fields are separated; whitespace by default.
+ * @param flush Whether prompts are flushed as they are written; see `PromptFlush`.
+ * @return The parsed fields.
+ * @throws std::runtime_error if the input ends before a valid record is read.
+ */
+template<typename... Ts, typename Validators = std::tuple<>>
+    requires (sizeof...(Ts) > 0 && record_validators_v<std::tuple<Ts...>, Validators>)
+std::tuple<Ts...> read_validated_record(std::istream& in, std::ostream& out, const std::string& prompt,
+                                        int indent_tabs = 0, const Validators& validators = {},
+                                        const std::string& error_message = "Invalid value.",
+                                        RecordFormat format = {}, PromptFlush flush = PromptFlush::Always) {
+    struct TieGuard {
+        std::istream& in;
+        std::ostream* tied;
+        ~TieGuard() { in.tie(tied); }
+    } guard{in, flush == PromptFlush::Buffered ? in.tie(nullptr) : in.tie()};
+
+    auto write = [&out, flush](const std::string& indent, const std::string& text) {
+        out << indent << text;
+        if (flush == PromptFlush::Always) {
+            out.flush();
+        }
+    };
+
+    std::tuple<Ts...> record{};
     std::string line;
     std::string indent(indent_tabs, '\t');
-    std::cout << indent << prompt;
+    write(indent, prompt);
     indent.push_back('\t');
     while (true) {
-        std::getline(std::cin, line);
-        std::stringstream ss(line);
+        if (!std::getline(in, line)) {
+            throw std::runtime_error("input ended before a valid record was read");
+        }
+        std::size_t field = 0;
+        RecordStatus status = parse_record(line, format, record, validators, field, std::index_sequence_for<Ts...>{});
+        if (status == RecordStatus::Ok) {
+            return record;
+        }
+        write(indent, record_error_message(status, field, sizeof...(Ts), error_message) + " Please try again.\n");
+    }
+}
 
-        if ((ss >> value) && (ss.eof())) {
-            //if there is a validation function, then use it
-            if (validator == nullptr || validator(value)) {
-                break; // input is valid
-            } else {
-                std::cout << indent << error_message;
-            }
+/**
+ * @brief Reads and validates a multi-field record from the console; see the stream overload.
+ */
+template<typename... Ts, typename Validators = std::tuple<>>
+    requires (sizeof...(Ts) > 0 && record_validators_v<std::tuple<Ts...>, Validators>)
+std::tuple<Ts...> read_validated_record(const std::string& prompt, int indent_tabs = 0,
+                                        const Validators& validators = {},
+                                        const std::string& error_message = "Invalid value.",
+                                        RecordFormat format = {}) {
+    return read_validated_record<Ts...>(std::cin, std::cout, prompt, indent_tabs, validators, error_message, format);
+}
+
+/**
+ * @brief Streams records, one per line, until end of input, collecting errors instead of re-prompting.
+ *
+ * For bulk imports of CSV, TSV or whitespace-separated files. Lines are read
+ * into one reused buffer and fields are parsed in place, so the only per-field
+ * allocation is the copy into a string field. Blank lines are skipped.
+ *
+ * @tparam Ts The field types, in line order.
+ * @tparam OutputIt An output iterator accepting `std::tuple<Ts...>`; each record is moved into it.
+ * @param in The stream to read from.
+ * @param format How fields are separated, e.g. `RecordFormat::csv()`.
+ * @param validators `std::tuple<>` for none, or one validator per field.
+ * @param out Receives each valid record, in input order.
+ * @param error_message The message recorded for records with a rejected field.
+ * @param skip_header Ignore the first line, e.g. a CSV column header.
+ * @return The number of records read, and each rejected line with its line
+ *         number and a message naming the failing field.
+ */
+template<typename... Ts, typename Validators, typename OutputIt>
+    requires (sizeof...(Ts) > 0 && record_validators_v<std::tuple<Ts...>, Validators>)
+BatchReadResult read_validated_records(std::istream& in, const RecordFormat& format, const Validators& validators,
+                                       OutputIt out, const std::string& error_message = "Invalid value.",
+                                       bool skip_header = false) {
+    BatchReadResult result;
+    std::tuple<Ts...> record{};
+    std::string buffer;
+    std::size_t line = 0;
+    if (skip_header && std::getline(in, buffer)) {
+        ++line;
+    }
+    while (std::getline(in, buffer)) {
+        ++line;
+        if (buffer.find_first_not_of(" \t\n\v\f\r") == std::string::npos) {
+            continue;
+        }
+        std::size_t field = 0;
+        RecordStatus status = parse_record(buffer, format, record, validators, field, std::index_sequence_for<Ts...>{});
+        if (status == RecordStatus::Ok) {
+            *out = std::move(record);
+            ++out;
+            ++result.values;
         } else {
-            std::cout << indent << "Invalid format. Please try again.\n";
+            std::string message = record_error_message(status, field, sizeof...(Ts), error_message);
+            if (status == RecordStatus::Rejected) {
+                message = "Field " + std::to_string(field) + ": " + message;
+            }
+            result.errors.push_back({line, buffer, std::move(message)});
         }
     }
-    return value;
-}
\ No newline at end of file
+    return result;
+}
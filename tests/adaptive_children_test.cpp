@@ -0,0 +1,150 @@
+/**
+ * @file adaptive_children_test.cpp
+ * @brief Regression tests for `AdaptiveChildren` node kinds and their transitions.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -Wall -Wextra -fsanitize=address,undefined -Iinclude tests/adaptive_children_test.cpp -o adaptive_children_test && ./adaptive_children_test
+ * @endcode
+ */
+
+#include <cstddef>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "Dictionary.hpp"
+#include "check.hpp"
+
+namespace {
+
+struct Leaf {
+    int id = 0;
+};
+
+/**
+ * @brief Heap allocation that can be told to fail after a number of calls.
+ */
+struct FailingAllocator {
+    int allocations_left = -1;
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        if (allocations_left == 0) {
+            throw std::bad_alloc();
+        }
+        if (allocations_left > 0) {
+            --allocations_left;
+        }
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+        ::operator delete(p, bytes, std::align_val_t(alignment));
+    }
+};
+
+using Table = AdaptiveChildren<Leaf, FailingAllocator>;
+
+/**
+ * @brief True if `table` holds exactly the children in `expected`, in `std::less<char>` order.
+ */
+bool holds(const Table &table, const std::map<char, Leaf*> &expected) {
+    if (table.size() != expected.size()) {
+        return false;
+    }
+    auto it = expected.begin();
+    for (auto [c, child] : table) {
+        if (it == expected.end() || it->first != c || it->second != child || table.find(c) != child) {
+            return false;
+        }
+        ++it;
+    }
+    return it == expected.end();
+}
+
+void grows_and_shrinks_through_every_kind() {
+    FailingAllocator alloc;
+    Table table(alloc);
+    std::vector<Leaf> leaves(256);
+    std::map<char, Leaf*> expected;
+    for (int i = 0; i < 256; ++i) {
+        char c = static_cast<char>(i);
+        table.insert(c, &leaves[static_cast<std::size_t>(i)], alloc);
+        expected[c] = &leaves[static_cast<std::size_t>(i)];
+        CHECK(holds(table, expected));
+    }
+    CHECK(table.table_bytes() > 0);
+    for (int i = 255; i >= 0; --i) {
+        char c = static_cast<char>(i);
+        table.erase(c, alloc);
+        expected.erase(c);
+        CHECK(holds(table, expected));
+        CHECK(table.find(c) == nullptr);
+    }
+    table.shrink_to_fit(alloc);
+    CHECK(table.table_bytes() == 0);
+    table.destroy(alloc);
+}
+
+void failed_shrink_keeps_every_child() {
+    FailingAllocator alloc;
+    Table table(alloc);
+    std::vector<Leaf> leaves(64);
+    std::map<char, Leaf*> expected;
+    for (int i = 0; i < 64; ++i) {
+        char c = static_cast<char>('0' + i);
+        table.insert(c, &leaves[static_cast<std::size_t>(i)], alloc);
+        expected[c] = &leaves[static_cast<std::size_t>(i)];
+    }
+    std::size_t full_bytes = table.table_bytes();
+    // Down to ten children, which would fit a Node16 if one could be allocated.
+    alloc.allocations_left = 0;
+    for (int i = 63; i >= 10; --i) {
+        char c = static_cast<char>('0' + i);
+        table.erase(c, alloc);
+        expected.erase(c);
+        CHECK(holds(table, expected));
+    }
+    CHECK(table.table_bytes() == full_bytes);
+    CHECK_THROWS(std::bad_alloc, table.shrink_to_fit(alloc));
+    CHECK(holds(table, expected));
+    alloc.allocations_left = -1;
+    table.shrink_to_fit(alloc);
+    CHECK(table.table_bytes() < full_bytes);
+    CHECK(holds(table, expected));
+    table.destroy(alloc);
+}
+
+void dictionary_matches_map_children() {
+    Dictionary<Leaf, ArenaNodeAllocator, AdaptiveChildren> adaptive;
+    Dictionary<Leaf> reference;
+    std::vector<Leaf> leaves(4000);
+    std::mt19937 rng(7);
+    for (std::size_t i = 0; i < leaves.size(); ++i) {
+        std::string key;
+        for (std::size_t n = 1 + rng() % 3; n > 0; --n) {
+            key.push_back(static_cast<char>(rng() % 64 + (rng() % 2 ? 0 : 160)));
+        }
+        if (rng() % 4 == 0) {
+            CHECK(adaptive.erase(key) == reference.erase(key));
+        } else {
+            adaptive.insert(&leaves[i], key);
+            reference.insert(&leaves[i], key);
+        }
+    }
+    std::vector<std::pair<std::string, Leaf*>> got, want;
+    adaptive.traverse_with_keys([&got](std::string_view key, Leaf* leaf) { got.emplace_back(key, leaf); });
+    reference.traverse_with_keys([&want](std::string_view key, Leaf* leaf) { want.emplace_back(key, leaf); });
+    CHECK(got == want);
+    CHECK(adaptive.size() == reference.size());
+}
+
+} // namespace
+
+int main() {
+    grows_and_shrinks_through_every_kind();
+    failed_shrink_keeps_every_child();
+    dictionary_matches_map_children();
+    return check_result();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @file check.hpp
+ * @brief The assertion used by the regression tests in this directory.
+ * @details Unlike `assert`, `CHECK` is not compiled out under `NDEBUG`. A failed
+ *          check prints its location and expression and the test keeps going;
+ *          `check_result()` then gives the exit status for `main`.
+ */
+
+inline int &check_failures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);  \
+            ++check_failures();                                                                 \
+        }                                                                                       \
+    } while (false)
+
+/**
+ * @brief Checks that `expression` throws an exception of type `Exception`.
+ */
+#define CHECK_THROWS(Exception, expression)       \
+    do {                                          \
+        bool thrown = false;                      \
+        try {                                     \
+            (void)(expression);                   \
+        } catch (const Exception &) {             \
+            thrown = true;                        \
+        }                                         \
+        CHECK(thrown && #expression " throws");   \
+    } while (false)
+
+/**
+ * @brief `EXIT_SUCCESS` if every check passed; prints a summary otherwise.
+ */
+inline int check_result() {
+    if (check_failures() == 0) {
+        return EXIT_SUCCESS;
+    }
+    std::fprintf(stderr, "%d check(s) failed\n", check_failures());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file ingest_test.cpp
+ * @brief Regression tests for the `ingest_words` bulk loader and `load_sorted`.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -Wall -Wextra -fsanitize=address,undefined -pthread -Iinclude tests/ingest_test.cpp -o ingest_test && ./ingest_test
+ * @endcode
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Dictionary.hpp"
+#include "DictionaryIngest.hpp"
+#include "check.hpp"
+
+namespace {
+
+std::vector<std::string> keys_of(const OwningDictionary<int> &dict) {
+    std::vector<std::string> keys;
+    dict.traverse_with_keys([&keys](std::string_view key, const int*) { keys.emplace_back(key); });
+    return keys;
+}
+
+void short_words_survive_chunk_moves() {
+    // Words short enough for the small-string buffer, in chunks of every size.
+    for (std::size_t chunk_words : {1, 2, 3, 1000}) {
+        std::istringstream in("bb a ccc a dd");
+        OwningDictionary<int> dict;
+        IngestOptions options;
+        options.chunk_words = chunk_words;
+        options.queue_depth = 1;
+        options.block_bytes = 3;
+        IngestStats stats = ingest_words(in, dict, [](std::string_view word) { return static_cast<int>(word.size()); },
+                                         nullptr, options);
+        CHECK(stats.words == 5 && stats.bytes == 13);
+        CHECK((keys_of(dict) == std::vector<std::string>{"a", "bb", "ccc", "dd"}));
+        CHECK(*dict.word_exist("ccc") == 3);
+    }
+}
+
+void matches_insert_on_random_input() {
+    std::mt19937 rng(11);
+    std::string text;
+    std::set<std::string> expected;
+    for (int i = 0; i < 20000; ++i) {
+        std::string word;
+        for (std::size_t n = 1 + rng() % 8; n > 0; --n) {
+            word.push_back(static_cast<char>(rng() % 2 ? 'a' + rng() % 6 : 0xC0 + rng() % 8));
+        }
+        text += word;
+        text += rng() % 5 ? " " : "\n\t";
+        if (word.size() <= 6) {
+            expected.insert(word);
+        }
+    }
+    std::istringstream in(text);
+    OwningDictionary<int> dict;
+    IngestOptions options;
+    options.chunk_words = 777;
+    options.block_bytes = 1000;
+    IngestStats stats = ingest_words(in, dict, [](std::string_view) { return 0; },
+                                     validators::length_between(1, 6), options);
+    CHECK(dict.size() == expected.size());
+    CHECK(stats.words + stats.rejected == 20000);
+    std::vector<std::string> keys = keys_of(dict);
+    CHECK(std::ranges::is_sorted(keys, [](const std::string &a, const std::string &b) {
+        return std::ranges::lexicographical_compare(a, b);
+    }));
+    CHECK(std::ranges::all_of(expected, [&dict](const std::string &word) { return dict.word_exist(word) != nullptr; }));
+}
+
+void move_only_values_are_moved_in() {
+    std::istringstream in("one two three two");
+    OwningDictionary<std::unique_ptr<std::string>> dict;
+    ingest_words(in, dict, [](std::string_view word) { return std::make_unique<std::string>(word); });
+    CHECK(dict.size() == 3 && **dict.word_exist("three") == "three");
+}
+
+void errors_stop_the_reader_and_keep_loaded_chunks() {
+    std::string text;
+    for (int i = 0; i < 100; ++i) {
+        text += "w" + std::to_string(i) + " ";
+    }
+    std::istringstream in(text);
+    OwningDictionary<int> dict;
+    IngestOptions options;
+    options.chunk_words = 10;
+    int calls = 0;
+    CHECK_THROWS(std::runtime_error, ingest_words(in, dict, [&calls](std::string_view) {
+        if (++calls > 25) {
+            throw std::runtime_error("value_for failed");
+        }
+        return 0;
+    }, nullptr, options));
+    CHECK(dict.size() == 20);
+}
+
+} // namespace
+
+int main() {
+    short_words_survive_chunk_moves();
+    matches_insert_on_random_input();
+    move_only_values_are_moved_in();
+    errors_stop_the_reader_and_keep_loaded_chunks();
+    return check_result();
+}
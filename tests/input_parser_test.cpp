@@ -0,0 +1,93 @@
+/**
+ * @file input_parser_test.cpp
+ * @brief Regression tests for `input_parser` and the validators of `input_utils.hpp`.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -Wall -Wextra -fsanitize=address,undefined -Iinclude tests/input_parser_test.cpp -o input_parser_test && ./input_parser_test
+ * @endcode
+ */
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include "input_utils.hpp"
+#include "check.hpp"
+
+namespace {
+
+template<class T>
+bool parses(std::string_view text, T expected) {
+    T value{};
+    return input_parser<T>::parse(text, value) && value == expected;
+}
+
+template<class T>
+bool rejects(std::string_view text) {
+    T value{};
+    T before = value;
+    return !input_parser<T>::parse(text, value) && value == before;
+}
+
+void integers() {
+    CHECK(parses<int>("42", 42));
+    CHECK(parses<int>("  -7", -7));
+    CHECK(parses<int>("+7", 7));
+    CHECK(parses<long long>("9223372036854775807", std::numeric_limits<long long>::max()));
+    CHECK(rejects<int>("2147483648"));
+    CHECK(rejects<int>("12x"));
+    CHECK(rejects<int>("1 2"));
+    CHECK(rejects<int>(""));
+    CHECK(rejects<int>("+"));
+    CHECK(rejects<int>("+-1"));
+    CHECK(rejects<int>("++1"));
+    CHECK(rejects<unsigned>("-1"));
+    CHECK(parses<unsigned>("4294967295", 4294967295u));
+}
+
+void floating_point() {
+    CHECK(parses<double>("2.5", 2.5));
+    CHECK(parses<double>("  +2.5e3", 2500.0));
+    CHECK(parses<double>("-0.125", -0.125));
+    CHECK(parses<float>("1e-3", 1e-3f));
+    for (const char* text : {"nan", "NaN", "-nan", "nan(1)", "inf", "-inf", "+inf", "infinity", "INF"}) {
+        CHECK(rejects<double>(text));
+        CHECK(rejects<float>(text));
+    }
+    CHECK(rejects<double>("1e999"));
+    CHECK(rejects<double>("1.5.2"));
+    CHECK(rejects<double>("0x10"));
+}
+
+void strings() {
+    CHECK(parses<std::string>("  word", std::string("word")));
+    CHECK(rejects<std::string>("two words"));
+    CHECK(rejects<std::string>("   "));
+}
+
+void between_rejects_unordered_values() {
+    auto unit = validators::between(0.0, 1.0);
+    CHECK(unit(0.0) && unit(0.5) && unit(1.0));
+    CHECK(!unit(-0.1) && !unit(1.1));
+    CHECK(!unit(std::nan("")));
+    CHECK(validators::between(1, 5)(5) && !validators::between(1, 5)(6));
+}
+
+void read_validated_input_skips_non_finite_values() {
+    std::istringstream in("nan\ninf\n0.25\n");
+    std::ostringstream out;
+    double value = read_validated_input<double>(in, out, "Ratio: ", 0, validators::between(0.0, 1.0));
+    CHECK(value == 0.25);
+}
+
+} // namespace
+
+int main() {
+    integers();
+    floating_point();
+    strings();
+    between_rejects_unordered_values();
+    read_validated_input_skips_non_finite_values();
+    return check_result();
+}
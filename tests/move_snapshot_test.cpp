@@ -0,0 +1,142 @@
+/**
+ * @file move_snapshot_test.cpp
+ * @brief Regression tests for moving `Dictionary` and for `PersistentDictionary` snapshots.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -Wall -Wextra -fsanitize=address,undefined -pthread -Iinclude tests/move_snapshot_test.cpp -o move_snapshot_test && ./move_snapshot_test
+ * @endcode
+ */
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Dictionary.hpp"
+#include "PersistentDictionary.hpp"
+#include "check.hpp"
+
+namespace {
+
+template<class Dict>
+bool empty_and_usable(Dict &dict, int* object) {
+    bool empty = dict.empty() && dict.size() == 0 && !dict.word_exist("a") && dict.count_prefix("") == 0;
+    int visited = 0;
+    dict.traverse([&visited](auto) { ++visited; });
+    empty = empty && visited == 0 && !dict.erase("a") && dict.erase_prefix("") == 0;
+    dict.insert(object, "a");
+    bool usable = dict.size() == 1 && dict.word_exist("a") == object;
+    dict.clear();
+    return empty && usable && dict.empty();
+}
+
+template<class Dict>
+void dictionary_moves() {
+    static_assert(std::is_nothrow_move_constructible_v<Dict>);
+    static_assert(std::is_nothrow_move_assignable_v<Dict>);
+    static_assert(std::is_nothrow_swappable_v<Dict>);
+    int x = 1;
+    int y = 2;
+
+    Dict source;
+    source.insert(&x, "alpha");
+    source.insert(&y, "beta");
+    Dict moved(std::move(source));
+    CHECK(moved.size() == 2 && moved.word_exist("alpha") == &x);
+    CHECK(empty_and_usable(source, &y));
+
+    Dict target;
+    target.insert(&y, "gamma");
+    target = std::move(moved);
+    CHECK(target.size() == 2 && !target.word_exist("gamma"));
+    CHECK(empty_and_usable(moved, &x));
+    Dict &alias = target;
+    target = std::move(alias);
+    CHECK(target.size() == 2);
+
+    Dict other;
+    other.insert(&x, "delta");
+    std::swap(target, other);
+    CHECK(target.size() == 1 && other.size() == 2);
+    CHECK(other.memory_stats().word_count == 2);
+
+    std::vector<Dict> many;
+    many.emplace_back();
+    many.back().insert(&x, "kept");
+    for (int i = 0; i < 16; ++i) {
+        many.emplace_back();
+    }
+    CHECK(many.front().word_exist("kept") == &x);
+}
+
+void fresh_dictionary_owns_no_nodes() {
+    Dictionary<int> dict;
+    CHECK(dict.memory_stats().node_count == 0);
+    CHECK(dict.prefix_exist(""));
+    int x = 0;
+    dict.insert(&x, "ab");
+    CHECK(dict.memory_stats().node_count == 3);
+    dict.clear();
+    CHECK(dict.memory_stats().node_count == 0 && dict.empty());
+}
+
+void snapshots_are_isolated() {
+    int a = 1;
+    int b = 2;
+    PersistentDictionary<int> dict;
+    dict.insert(&a, "apple");
+    PersistentDictionary<int> frozen = dict.snapshot();
+    dict.insert(&b, "apply");
+    dict.erase("apple");
+    CHECK(frozen.size() == 1 && frozen.word_exist("apple") == &a && !frozen.word_exist("apply"));
+    CHECK(dict.size() == 1 && dict.word_exist("apply") == &b && !dict.word_exist("apple"));
+
+    dict.insert(nullptr, "apply");
+    CHECK(dict.size() == 0 && !dict.prefix_exist("a"));
+    dict.insert(nullptr, "missing");
+    CHECK(dict.size() == 0);
+
+    std::thread reader([frozen] {
+        int seen = 0;
+        for (int i = 0; i < 1000; ++i) {
+            frozen.traverse([&seen](int*) { ++seen; });
+        }
+        CHECK(seen == 1000);
+    });
+    for (int i = 0; i < 1000; ++i) {
+        dict.insert(&a, std::to_string(i));
+    }
+    reader.join();
+    CHECK(dict.size() == 1000 && frozen.size() == 1);
+}
+
+void deep_trees_assign_without_recursion() {
+    int a = 1;
+    std::string deep(200000, 'x');
+    PersistentDictionary<int> dict;
+    PersistentDictionary<int> small;
+    small.insert(&a, "s");
+
+    dict.insert(&a, deep);
+    dict = small;
+    CHECK(dict.word_exist("s") && !dict.word_exist(deep));
+    dict.insert(&a, deep);
+    dict = std::move(small);
+    CHECK(dict.word_exist("s") && dict.size() == 1);
+    const PersistentDictionary<int> &self = dict;
+    dict = self;
+    CHECK(dict.word_exist("s"));
+    dict.insert(&a, deep);
+}
+
+} // namespace
+
+int main() {
+    dictionary_moves<Dictionary<int>>();
+    dictionary_moves<Dictionary<int, ArenaNodeAllocator, AdaptiveChildren>>();
+    fresh_dictionary_owns_no_nodes();
+    snapshots_are_isolated();
+    deep_trees_assign_without_recursion();
+    return check_result();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file owned_values_test.cpp
+ * @brief Regression tests for `OwningDictionary`: value lifetime and exception safety.
+ *
+ * Build and run:
+ * @code
+ * g++ -std=c++20 -Wall -Wextra -fsanitize=address,undefined -Iinclude tests/owned_values_test.cpp -o owned_values_test && ./owned_values_test
+ * @endcode
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Dictionary.hpp"
+#include "check.hpp"
+
+namespace {
+
+/**
+ * @brief A value that counts live instances and can be told to throw on a later copy.
+ */
+struct Tracked {
+    static inline int live = 0;
+    static inline int copies_left = -1;
+
+    int id;
+
+    explicit Tracked(int id) : id(id) {
+        if (id < 0) {
+            throw std::runtime_error("negative id");
+        }
+        ++live;
+    }
+
+    Tracked(const Tracked &other) : id(other.id) {
+        if (copies_left == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        if (copies_left > 0) {
+            --copies_left;
+        }
+        ++live;
+    }
+
+    Tracked(Tracked &&other) noexcept : id(other.id) {
+        ++live;
+    }
+
+    Tracked &operator=(const Tracked &) = default;
+    Tracked &operator=(Tracked &&) noexcept = default;
+
+    ~Tracked() {
+        --live;
+    }
+};
+
+template<class Dict>
+void values_are_destroyed_with_their_words() {
+    {
+        Dict dict;
+        dict.emplace("alpha", 1);
+        dict.emplace("alphabet", 2);
+        dict.emplace("beta", 3);
+        CHECK(Tracked::live == 3);
+        dict.emplace("alpha", 4);
+        CHECK(Tracked::live == 3 && dict.word_exist("alpha")->id == 4);
+        CHECK(dict.erase("beta"));
+        CHECK(Tracked::live == 2);
+        CHECK(dict.erase_prefix("alpha") == 2);
+        CHECK(Tracked::live == 0 && dict.empty());
+        dict.emplace("gamma", 5);
+        dict.clear();
+        CHECK(Tracked::live == 0);
+        dict.emplace("delta", 6);
+        dict.compact();
+        CHECK(Tracked::live == 1 && dict.word_exist("delta")->id == 6);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+void replacement_may_alias_the_old_value() {
+    OwningDictionary<std::string> dict;
+    std::string long_value(100, 'x');
+    dict.emplace("k", long_value);
+    dict.emplace("k", *dict.word_exist("k"));
+    CHECK(*dict.word_exist("k") == long_value);
+    dict.insert("k", std::string(*dict.word_exist("k")) + "y");
+    CHECK(*dict.word_exist("k") == long_value + "y");
+}
+
+void throwing_construction_changes_nothing() {
+    OwningDictionary<Tracked> dict;
+    dict.emplace("abc", 1);
+    CHECK_THROWS(std::runtime_error, dict.emplace("abc", -1));
+    CHECK(dict.size() == 1 && dict.word_exist("abc") && dict.word_exist("abc")->id == 1);
+    CHECK_THROWS(std::runtime_error, dict.emplace("abd", -1));
+    CHECK(dict.size() == 1 && !dict.prefix_exist("abd") && dict.count_prefix("ab") == 1);
+    CHECK(dict.memory_stats().node_count == 4);
+}
+
+void failed_bulk_load_keeps_earlier_entries() {
+    OwningDictionary<Tracked> dict;
+    dict.emplace("apple", 0);
+    std::vector<std::pair<std::string, Tracked>> entries;
+    for (const char* word : {"bob", "ant", "apples", "apex", "applesauce"}) {
+        entries.emplace_back(word, Tracked(static_cast<int>(entries.size()) + 1));
+    }
+    // Sorted: ant, apex, apples, applesauce, bob. The third copy throws.
+    Tracked::copies_left = 2;
+    CHECK_THROWS(std::runtime_error, dict.insert_batch(entries));
+    Tracked::copies_left = -1;
+    CHECK(dict.size() == 3);
+    CHECK(dict.count_prefix("a") == 3 && dict.count_prefix("ap") == 2);
+    CHECK(!dict.prefix_exist("apples") && !dict.prefix_exist("b"));
+    CHECK(dict.memory_stats().word_count == 3);
+    CHECK(Tracked::live == 3 + static_cast<int>(entries.size()));
+    dict.emplace("apples", 9);
+    CHECK(dict.count_prefix("app") == 2 && dict.size() == 4);
+}
+
+void rvalue_load_moves_values() {
+    OwningDictionary<std::unique_ptr<int>> dict;
+    std::vector<std::pair<std::string, std::unique_ptr<int>>> entries;
+    entries.emplace_back("a", std::make_unique<int>(1));
+    entries.emplace_back("b", std::make_unique<int>(2));
+    dict.load_sorted(std::move(entries));
+    CHECK(dict.size() == 2 && **dict.word_exist("b") == 2);
+}
+
+} // namespace
+
+int main() {
+    values_are_destroyed_with_their_words<OwningDictionary<Tracked>>();
+    values_are_destroyed_with_their_words<OwningDictionary<Tracked, ArenaNodeAllocator, AdaptiveChildren>>();
+    replacement_may_alias_the_old_value();
+    throwing_construction_changes_nothing();
+    failed_bulk_load_keeps_earlier_entries();
+    rvalue_load_moves_values();
+    CHECK(Tracked::live == 0);
+    return check_result();
+}